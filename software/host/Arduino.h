@@ -0,0 +1,67 @@
+/**
+ * Host stand-in for the subset of the Arduino core used by the firmware. The
+ * hardware behind these functions is simulated by sim.cpp.
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <avr/pgmspace.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+// The Arduino Pro Mini's clock frequency
+#define F_CPU 16000000ul
+
+#define HIGH 0x1
+#define LOW  0x0
+
+#define INPUT  0x0
+#define OUTPUT 0x1
+
+typedef uint8_t byte;
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t value);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+// Called while busy-waiting. On the host this lets virtual time advance to the
+// next simulated hardware event (e.g. an SPI transfer completing).
+void yield(void);
+
+long random(long max);
+long random(long min, long max);
+void randomSeed(unsigned long seed);
+
+// Flash strings are ordinary strings on the host
+#define F(s) (s)
+
+class HardwareSerial {
+	public:
+		void begin(unsigned long baud);
+		
+		void print(const char *str);
+		void print(char c);
+		void print(int n);
+		void print(unsigned int n);
+		void print(long n);
+		void print(unsigned long n);
+		
+		void println(void);
+		template <typename T> void println(T value) { print(value); println(); }
+};
+
+extern HardwareSerial Serial;
+
+#endif
@@ -0,0 +1,18 @@
+/**
+ * Host stand-in for the DS1307RTC library backed by the simulated RTC.
+ */
+
+#ifndef HOST_DS1307RTC_H
+#define HOST_DS1307RTC_H
+
+#include <Time.h>
+
+class DS1307RTC {
+	public:
+		static time_t get(void);
+		static bool set(time_t t);
+};
+
+extern DS1307RTC RTC;
+
+#endif
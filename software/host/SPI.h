@@ -0,0 +1,45 @@
+/**
+ * Host stand-in for the Arduino SPI library. Bytes transferred are delivered to
+ * the simulated MAX7219 chain.
+ */
+
+#ifndef HOST_SPI_H
+#define HOST_SPI_H
+
+#include <Arduino.h>
+
+#define SPI_MODE0 0x00
+#define SPI_MODE1 0x04
+#define SPI_MODE2 0x08
+#define SPI_MODE3 0x0C
+
+#define LSBFIRST 0
+#define MSBFIRST 1
+
+#define SPI_CLOCK_DIV4   0x00
+#define SPI_CLOCK_DIV16  0x01
+#define SPI_CLOCK_DIV64  0x02
+#define SPI_CLOCK_DIV128 0x03
+#define SPI_CLOCK_DIV2   0x04
+#define SPI_CLOCK_DIV8   0x05
+#define SPI_CLOCK_DIV32  0x06
+
+class SPIClass {
+	public:
+		void begin(void);
+		void end(void);
+		
+		void setDataMode(uint8_t mode);
+		void setBitOrder(uint8_t order);
+		void setClockDivider(uint8_t divider);
+		
+		uint8_t transfer(uint8_t data);
+		
+		// Enable/disable the SPI transfer complete interrupt (SPI_STC_vect)
+		void attachInterrupt(void);
+		void detachInterrupt(void);
+};
+
+extern SPIClass SPI;
+
+#endif
@@ -0,0 +1,38 @@
+/**
+ * Host stand-in for the subset of the Arduino Time library used by the
+ * firmware.
+ */
+
+#ifndef HOST_TIME_H
+#define HOST_TIME_H
+
+#include <time.h>
+
+typedef enum {
+	timeNotSet,
+	timeNeedsSync,
+	timeSet,
+} timeStatus_t;
+
+typedef time_t (*getExternalTime)(void);
+
+time_t now(void);
+void setTime(time_t t);
+void setSyncProvider(getExternalTime get_time_function);
+timeStatus_t timeStatus(void);
+
+int second(void);
+int minute(void);
+int hour(void);
+int day(void);
+int month(void);
+int year(void);
+
+int second(time_t t);
+int minute(time_t t);
+int hour(time_t t);
+int day(time_t t);
+int month(time_t t);
+int year(time_t t);
+
+#endif
@@ -0,0 +1,8 @@
+/**
+ * Host stand-in for the Arduino Wire library (the RTC is simulated directly).
+ */
+
+#ifndef HOST_WIRE_H
+#define HOST_WIRE_H
+
+#endif
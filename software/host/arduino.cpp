@@ -0,0 +1,256 @@
+/**
+ * Implementation of the Arduino core and library stand-ins on top of the
+ * simulated hardware.
+ */
+
+#include <Arduino.h>
+#include <SPI.h>
+#include <Time.h>
+#include <DS1307RTC.h>
+#include <avr/eeprom.h>
+
+#include "sim.h"
+#include "max7219.h"
+
+// Defined in sim.cpp
+void sim_digital_write(int pin, bool value);
+bool sim_digital_read(int pin);
+int sim_analog_read(int pin);
+void sim_spi_write(uint8_t data);
+void sim_spi_interrupt_enable(bool enabled);
+void sim_yield(void);
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Arduino core
+////////////////////////////////////////////////////////////////////////////////
+
+void pinMode(uint8_t pin, uint8_t mode) {
+	// Nothing to do
+}
+
+void digitalWrite(uint8_t pin, uint8_t value) {
+	sim_digital_write(pin, value != LOW);
+}
+
+int digitalRead(uint8_t pin) {
+	return sim_digital_read(pin) ? HIGH : LOW;
+}
+
+int analogRead(uint8_t pin) {
+	return sim_analog_read(pin);
+}
+
+
+unsigned long millis(void) {
+	return (unsigned long)(sim_time_us() / 1000ull);
+}
+
+unsigned long micros(void) {
+	return (unsigned long)sim_time_us();
+}
+
+void delay(unsigned long ms) {
+	sim_advance_us(ms * 1000ull);
+}
+
+void delayMicroseconds(unsigned int us) {
+	sim_advance_us(us);
+}
+
+void yield(void) {
+	sim_yield();
+}
+
+
+void cli(void) {
+	SREG &= ~_BV(SREG_I);
+}
+
+void sei(void) {
+	SREG |= _BV(SREG_I);
+}
+
+
+static unsigned long random_state = 1;
+
+long random(long max) {
+	if (max == 0)
+		return 0;
+	
+	// Simple LCG so runs are repeatable regardless of the host's libc
+	random_state = (random_state * 1103515245ul + 12345ul) & 0x7FFFFFFFul;
+	return (long)(random_state % (unsigned long)max);
+}
+
+long random(long min, long max) {
+	if (min >= max)
+		return min;
+	return min + random(max - min);
+}
+
+void randomSeed(unsigned long seed) {
+	if (seed != 0)
+		random_state = seed;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Serial (sent to stderr)
+////////////////////////////////////////////////////////////////////////////////
+
+HardwareSerial Serial;
+
+void HardwareSerial::begin(unsigned long baud) {}
+
+void HardwareSerial::print(const char *str)   { fputs(str, stderr); }
+void HardwareSerial::print(char c)            { fputc(c, stderr); }
+void HardwareSerial::print(int n)             { fprintf(stderr, "%d", n); }
+void HardwareSerial::print(unsigned int n)    { fprintf(stderr, "%u", n); }
+void HardwareSerial::print(long n)            { fprintf(stderr, "%ld", n); }
+void HardwareSerial::print(unsigned long n)   { fprintf(stderr, "%lu", n); }
+
+void HardwareSerial::println(void) { fputc('\n', stderr); }
+
+
+////////////////////////////////////////////////////////////////////////////////
+// SPI
+////////////////////////////////////////////////////////////////////////////////
+
+SPIClass SPI;
+
+void SPIClass::begin(void) {}
+void SPIClass::end(void) {}
+void SPIClass::setDataMode(uint8_t mode) {}
+void SPIClass::setBitOrder(uint8_t order) {}
+void SPIClass::setClockDivider(uint8_t divider) {
+	unsigned long div;
+	switch (divider) {
+		case SPI_CLOCK_DIV2:   div = 2;   break;
+		default:
+		case SPI_CLOCK_DIV4:   div = 4;   break;
+		case SPI_CLOCK_DIV8:   div = 8;   break;
+		case SPI_CLOCK_DIV16:  div = 16;  break;
+		case SPI_CLOCK_DIV32:  div = 32;  break;
+		case SPI_CLOCK_DIV64:  div = 64;  break;
+		case SPI_CLOCK_DIV128: div = 128; break;
+	}
+	max7219_set_sck_hz(F_CPU / div);
+}
+
+uint8_t SPIClass::transfer(uint8_t data) {
+	// The transfer blocks for as long as it takes to clock the byte out
+	sim_advance_ns(max7219_shift(data));
+	return 0;
+}
+
+void SPIClass::attachInterrupt(void) {
+	sim_spi_interrupt_enable(true);
+}
+
+void SPIClass::detachInterrupt(void) {
+	sim_spi_interrupt_enable(false);
+}
+
+
+SimSPDR SPDR;
+
+SimSPDR &SimSPDR::operator=(uint8_t data) {
+	sim_spi_write(data);
+	return *this;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Time library
+////////////////////////////////////////////////////////////////////////////////
+
+// System time at millis() == sys_time_millis
+static time_t sys_time;
+static unsigned long sys_time_millis;
+static timeStatus_t status = timeNotSet;
+
+time_t now(void) {
+	return sys_time + (time_t)((millis() - sys_time_millis) / 1000ul);
+}
+
+void setTime(time_t t) {
+	sys_time = t;
+	sys_time_millis = millis();
+	status = timeSet;
+}
+
+void setSyncProvider(getExternalTime get_time_function) {
+	time_t t = get_time_function();
+	if (t != 0)
+		setTime(t);
+}
+
+timeStatus_t timeStatus(void) {
+	return status;
+}
+
+static struct tm break_time(time_t t) {
+	struct tm tm;
+	gmtime_r(&t, &tm);
+	return tm;
+}
+
+int second(time_t t) { return break_time(t).tm_sec; }
+int minute(time_t t) { return break_time(t).tm_min; }
+int hour(time_t t)   { return break_time(t).tm_hour; }
+int day(time_t t)    { return break_time(t).tm_mday; }
+int month(time_t t)  { return break_time(t).tm_mon + 1; }
+int year(time_t t)   { return break_time(t).tm_year + 1900; }
+
+int second(void) { return second(now()); }
+int minute(void) { return minute(now()); }
+int hour(void)   { return hour(now()); }
+int day(void)    { return day(now()); }
+int month(void)  { return month(now()); }
+int year(void)   { return year(now()); }
+
+
+////////////////////////////////////////////////////////////////////////////////
+// DS1307 RTC
+////////////////////////////////////////////////////////////////////////////////
+
+DS1307RTC RTC;
+
+time_t DS1307RTC::get(void) {
+	return sim_rtc_get();
+}
+
+bool DS1307RTC::set(time_t t) {
+	sim_rtc_set(t);
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// EEPROM
+////////////////////////////////////////////////////////////////////////////////
+
+static uint8_t eeprom[E2END + 1];
+static bool eeprom_erased = false;
+
+/**
+ * Get the address of a byte of EEPROM, erasing the EEPROM on first use.
+ */
+static uint8_t *eeprom_byte(const void *addr) {
+	if (!eeprom_erased) {
+		memset(eeprom, 0xFF, sizeof(eeprom));
+		eeprom_erased = true;
+	}
+	return eeprom + ((uintptr_t)addr % sizeof(eeprom));
+}
+
+void eeprom_read_block(void *dst, const void *src, size_t n) {
+	for (size_t i = 0; i < n; i++)
+		((uint8_t *)dst)[i] = *eeprom_byte((const uint8_t *)src + i);
+}
+
+void eeprom_update_block(const void *src, void *dst, size_t n) {
+	for (size_t i = 0; i < n; i++)
+		*eeprom_byte((uint8_t *)dst + i) = ((const uint8_t *)src)[i];
+}
@@ -0,0 +1,38 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "asset_pack.h"
+
+
+int line_pool_index(line_pool_t *pool, uint16_t line) {
+	if (pool->empty())
+		pool->push_back(0);
+	
+	size_t i;
+	for (i = 0; i < pool->size(); i++)
+		if ((*pool)[i] == line)
+			return i;
+	
+	if (pool->size() >= 256) {
+		fprintf(stderr, "ERROR: Too many distinct lines to index with a byte\n");
+		exit(1);
+	}
+	
+	pool->push_back(line);
+	return i;
+}
+
+
+void line_pool_print(const line_pool_t *pool, const char *name, int num_pixels, bool msb_first) {
+	printf("PROGMEM prog_uint16_t %s[%zu] = {\n", name, pool->size());
+	for (size_t i = 0; i < pool->size(); i++) {
+		printf("\t0x%04X, // %3zu ", (*pool)[i], i);
+		for (int p = 0; p < num_pixels; p++) {
+			int bit = msb_first ? (num_pixels - 1 - p) : p;
+			printf("%c", ((*pool)[i] >> bit) & 1 ? '#' : '.');
+		}
+		printf("\n");
+	}
+	printf("};\n");
+}
+
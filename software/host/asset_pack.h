@@ -0,0 +1,38 @@
+/**
+ * Helpers shared by the generators which pack the firmware's bitmaps into
+ * flash.
+ *
+ * Bitmaps are stored as a series of lines (rows or columns of up to 16 pixels)
+ * cropped to those which can be visible. Identical lines are stored only once,
+ * in a pool of distinct lines, and each bitmap is stored as a series of
+ * single-byte indices into the pool.
+ */
+
+#ifndef ASSET_PACK_H
+#define ASSET_PACK_H
+
+#include <stdint.h>
+
+#include <vector>
+
+/**
+ * A pool of distinct lines.
+ */
+typedef std::vector<uint16_t> line_pool_t;
+
+/**
+ * Get the index of a line in the pool, adding it if it is not already present.
+ * The empty line is always index 0.
+ *
+ * Exits with an error if the pool can no longer be indexed with a byte.
+ */
+int line_pool_index(line_pool_t *pool, uint16_t line);
+
+/**
+ * Print a pool as a PROGMEM array of words named name with an ASCII-art
+ * rendering of each line. The first pixel of each line is in bit
+ * (num_pixels - 1) if msb_first, otherwise bit 0.
+ */
+void line_pool_print(const line_pool_t *pool, const char *name, int num_pixels, bool msb_first);
+
+#endif
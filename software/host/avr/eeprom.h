@@ -0,0 +1,19 @@
+/**
+ * Host stand-in for avr-libc's EEPROM support. The EEPROM is ordinary memory
+ * which starts erased (every byte 0xFF) and, like the real thing, is left
+ * untouched by sim_begin.
+ */
+
+#ifndef HOST_AVR_EEPROM_H
+#define HOST_AVR_EEPROM_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Address of the last byte of EEPROM (an ATmega328P's 1 KB)
+#define E2END 0x3FF
+
+void eeprom_read_block(void *dst, const void *src, size_t n);
+void eeprom_update_block(const void *src, void *dst, size_t n);
+
+#endif
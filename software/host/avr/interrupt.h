@@ -0,0 +1,21 @@
+/**
+ * Host stand-in for avr-libc's interrupt support. Interrupt handlers are
+ * ordinary functions which the simulator calls as virtual time advances past
+ * the events which trigger them.
+ */
+
+#ifndef HOST_AVR_INTERRUPT_H
+#define HOST_AVR_INTERRUPT_H
+
+#define ISR(vector) void vector(void)
+
+// Handlers for the interrupts the simulator can raise. Declared weak so that
+// programs which don't define a handler still link.
+void SPI_STC_vect(void) __attribute__((weak));
+void ADC_vect(void) __attribute__((weak));
+void TIMER2_COMPA_vect(void) __attribute__((weak));
+
+void cli(void);
+void sei(void);
+
+#endif
@@ -0,0 +1,98 @@
+/**
+ * Host stand-in for the subset of avr-libc's I/O register definitions used by
+ * the firmware. Registers are backed by the simulated hardware.
+ */
+
+#ifndef HOST_AVR_IO_H
+#define HOST_AVR_IO_H
+
+#include <stdint.h>
+
+#define _BV(bit) (1 << (bit))
+
+/**
+ * The SPI data register: writing a byte starts clocking it out to the
+ * simulated MAX7219 chain. The SPI transfer complete interrupt fires once the
+ * byte has been sent (if enabled with SPI.attachInterrupt()).
+ */
+class SimSPDR {
+	public:
+		SimSPDR &operator=(uint8_t data);
+		operator uint8_t() const { return 0; }
+};
+
+extern SimSPDR SPDR;
+
+/**
+ * An interrupt flag register: flags are set by the hardware and cleared by
+ * writing a one to them.
+ */
+class SimFlagRegister {
+	public:
+		uint8_t flags;
+		
+		SimFlagRegister &operator=(uint8_t clear) { flags &= ~clear; return *this; }
+		operator uint8_t() const { return flags; }
+};
+
+// Status register (only the global interrupt enable bit is simulated)
+extern volatile uint8_t SREG;
+#define SREG_I 7
+
+// Timer1 (only clear-timer-on-compare mode is simulated)
+extern volatile uint8_t  TCCR1A;
+extern volatile uint8_t  TCCR1B;
+extern volatile uint16_t TCNT1;
+extern volatile uint16_t OCR1A;
+extern volatile uint16_t OCR1B;
+extern volatile uint8_t  TIMSK1;
+extern SimFlagRegister  TIFR1;
+
+#define WGM12 3
+#define CS12  2
+#define CS11  1
+#define CS10  0
+
+#define OCF1B 2
+#define OCF1A 1
+
+// Timer2 (only clear-timer-on-compare mode with OCR2A as TOP is simulated)
+extern volatile uint8_t TCCR2A;
+extern volatile uint8_t TCCR2B;
+extern volatile uint8_t TCNT2;
+extern volatile uint8_t OCR2A;
+extern volatile uint8_t TIMSK2;
+extern SimFlagRegister TIFR2;
+
+#define WGM21 1
+#define CS22  2
+#define CS21  1
+#define CS20  0
+
+#define OCIE2A 1
+#define OCF2A  1
+
+// ADC (only conversions auto-triggered by Timer1 compare match B are
+// simulated; conversions complete instantly)
+extern volatile uint8_t  ADMUX;
+extern volatile uint8_t  ADCSRA;
+extern volatile uint8_t  ADCSRB;
+extern volatile uint16_t ADC;
+
+#define REFS1 7
+#define REFS0 6
+
+#define ADEN  7
+#define ADSC  6
+#define ADATE 5
+#define ADIF  4
+#define ADIE  3
+#define ADPS2 2
+#define ADPS1 1
+#define ADPS0 0
+
+#define ADTS2 2
+#define ADTS1 1
+#define ADTS0 0
+
+#endif
@@ -0,0 +1,27 @@
+/**
+ * Host stand-in for avr-libc's program memory support: on the host program
+ * memory is ordinary memory.
+ */
+
+#ifndef HOST_AVR_PGMSPACE_H
+#define HOST_AVR_PGMSPACE_H
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+
+typedef char          prog_char;
+typedef unsigned char prog_uchar;
+typedef uint16_t      prog_uint16_t;
+
+#define pgm_read_byte_near(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word_near(addr) (*(const uint16_t *)(addr))
+#define pgm_read_byte(addr)      pgm_read_byte_near(addr)
+#define pgm_read_word(addr)      pgm_read_word_near(addr)
+
+#define memcpy_P memcpy
+#define strlen_P strlen
+
+#endif
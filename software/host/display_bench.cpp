@@ -0,0 +1,195 @@
+/**
+ * Drives the firmware's display code with a series of workloads, checking the
+ * image reconstructed by the MAX7219 chain emulator matches every frame sent
+ * and reporting the SPI cost of each workload. The greyscale workload instead
+ * checks that the greyscale engine never has to show a bit-plane late (i.e.
+ * that a plane can always be sent within a GREY_SLOT_USEC slot).
+ *
+ * Usage:
+ *
+ *   display_bench [-n frames]
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <Arduino.h>
+
+#include "word_clock.h"
+#include "frame.h"
+#include "display.h"
+#include "grey.h"
+#include "sim.h"
+#include "max7219.h"
+
+
+typedef enum {
+	// The same frame every time
+	WORKLOAD_STATIC,
+	
+	// A single pixel toggled each frame
+	WORKLOAD_ONE_PIXEL,
+	
+	// The intensity changed each frame but not the pixels
+	WORKLOAD_INTENSITY,
+	
+	// The intensity of one display changed each frame but not the pixels
+	WORKLOAD_DISPLAY_INTENSITY,
+	
+	// A completely random frame each time
+	WORKLOAD_RANDOM,
+	
+	// Alternating between two random frames (as a cross-fade does)
+	WORKLOAD_ALTERNATE,
+	
+	// A cross-fade between two random frames shown by the greyscale engine, one
+	// cycle per frame
+	WORKLOAD_GREY_FADE,
+	
+	NUM_WORKLOADS,
+} workload_t;
+
+static const char *WORKLOAD_NAMES[NUM_WORKLOADS] = {
+	"static",
+	"one pixel",
+	"intensity",
+	"disp int",
+	"random",
+	"alternate",
+	"grey fade",
+};
+
+
+static void random_frame(frame_t *buf) {
+	for (int y = 0; y < HEIGHT; y++)
+		buf->rows[y] = (frame_row_t)rand() & FRAME_ROW_MASK;
+}
+
+
+/**
+ * Check the emulated display shows the given frame at the given global
+ * intensity, with each display scaled by its own intensity.
+ *
+ * @returns The number of mismatching pixels.
+ */
+static int check(const frame_t *buf, int intensity,
+                 int display_intensities[DISPLAYS_Y][DISPLAYS_X]) {
+	int errors = 0;
+	for (int y = 0; y < HEIGHT; y++) {
+		for (int x = 0; x < WIDTH; x++) {
+			int display_intensity = display_intensities[y / DISPLAY_HEIGHT][x / DISPLAY_WIDTH];
+			if (max7219_pixel(x, y) != frame_get(buf, x, y)
+			    || max7219_intensity(x, y) != (intensity * (display_intensity + 1)) >> 4)
+				errors++;
+		}
+	}
+	return errors;
+}
+
+
+int main(int argc, char *argv[]) {
+	int num_frames = 1000;
+	
+	int opt;
+	while ((opt = getopt(argc, argv, "n:")) != -1) {
+		switch (opt) {
+			case 'n': num_frames = atoi(optarg); break;
+			default:
+				fprintf(stderr, "Usage: %s [-n frames]\n", argv[0]);
+				return 1;
+		}
+	}
+	
+	int total_errors = 0;
+	
+	printf("%-10s %12s %12s %12s %12s\n",
+	       "workload", "bytes/frame", "latch/frame", "wire us/fr", "errors");
+	for (int workload = 0; workload < NUM_WORKLOADS; workload++) {
+		sim_begin(0);
+		srand(workload);
+		display_begin();
+		grey_begin();
+		
+		frame_t frames[2];
+		random_frame(&frames[0]);
+		random_frame(&frames[1]);
+		int intensity = 0xF;
+		int display_intensities[DISPLAYS_Y][DISPLAYS_X];
+		for (int y = 0; y < DISPLAYS_Y; y++)
+			for (int x = 0; x < DISPLAYS_X; x++)
+				display_intensities[y][x] = 0xF;
+		
+		// Send an initial frame so each workload starts from the same point
+		display_buf(&frames[0], intensity);
+		display_wait();
+		max7219_reset_stats();
+		
+		int errors = 0;
+		for (int i = 0; i < num_frames; i++) {
+			if (workload == WORKLOAD_GREY_FADE) {
+				grey_frame_t grey;
+				grey_frame_blend(&grey, &frames[0], &frames[1], i % GREY_LEVELS);
+				grey_show(&grey, intensity);
+				sim_advance_us(GREY_MAX * GREY_SLOT_USEC);
+				continue;
+			}
+			
+			const frame_t *buf = &frames[0];
+			switch (workload) {
+				case WORKLOAD_STATIC:
+					break;
+				
+				case WORKLOAD_ONE_PIXEL: {
+					int x = rand() % WIDTH;
+					int y = rand() % HEIGHT;
+					frame_set(&frames[0], x, y, !frame_get(&frames[0], x, y));
+					break;
+				}
+				
+				case WORKLOAD_INTENSITY:
+					intensity = rand() % 16;
+					break;
+				
+				case WORKLOAD_DISPLAY_INTENSITY: {
+					int x = rand() % DISPLAYS_X;
+					int y = rand() % DISPLAYS_Y;
+					display_intensities[y][x] = rand() % 16;
+					display_set_display_intensity(x, y, display_intensities[y][x]);
+					break;
+				}
+				
+				case WORKLOAD_RANDOM:
+					random_frame(&frames[0]);
+					break;
+				
+				case WORKLOAD_ALTERNATE:
+					buf = &frames[i & 1];
+					break;
+			}
+			
+			display_buf(buf, intensity);
+			display_wait();
+			errors += check(buf, intensity, display_intensities);
+		}
+		
+		if (workload == WORKLOAD_GREY_FADE) {
+			grey_stop();
+			errors += grey_late_planes();
+		}
+		
+		max7219_stats_t stats;
+		max7219_get_stats(&stats);
+		errors += stats.misaligned_latches;
+		total_errors += errors;
+		
+		printf("%-10s %12.1f %12.2f %12.1f %12d\n",
+		       WORKLOAD_NAMES[workload],
+		       (double)stats.bytes / num_frames,
+		       (double)stats.latches / num_frames,
+		       (stats.wire_ns / 1e3) / num_frames,
+		       errors);
+	}
+	
+	return total_errors ? 1 : 0;
+}
@@ -0,0 +1,64 @@
+/**
+ * Generates dissolve_order.h: a random permutation of every pixel on the
+ * display, used as the order in which pixels change in the dissolve tween.
+ * Each entry is a pixel's index, (y * WIDTH) + x.
+ *
+ * Usage:
+ *
+ *   gen_dissolve_order > ../word_clock/dissolve_order.h
+ *
+ * The shuffle uses its own fixed-seed generator so the table is the same
+ * whichever host it is generated on.
+ */
+
+#include <stdio.h>
+
+#include <Arduino.h>
+
+#include "word_clock.h"
+
+#define NUM_PIXELS ((WIDTH) * (HEIGHT))
+
+#if NUM_PIXELS > 256
+	#error "Pixel indices no longer fit in a byte"
+#endif
+
+// Seed for the shuffle
+#define SEED 0x20140104ul
+
+/**
+ * A 32-bit linear congruential generator (Numerical Recipes' constants).
+ */
+static unsigned long next_random(unsigned long *state) {
+	*state = ((*state * 1664525ul) + 1013904223ul) & 0xFFFFFFFFul;
+	return *state >> 8;
+}
+
+
+int main(int argc, char *argv[]) {
+	int order[NUM_PIXELS];
+	for (int i = 0; i < NUM_PIXELS; i++)
+		order[i] = i;
+	
+	// Fisher-Yates shuffle
+	unsigned long state = SEED;
+	for (int i = NUM_PIXELS - 1; i > 0; i--) {
+		int j = next_random(&state) % (i + 1);
+		int tmp = order[i];
+		order[i] = order[j];
+		order[j] = tmp;
+	}
+	
+	printf("/**\n");
+	printf(" * Automatically-generated dissolve pixel order.\n");
+	printf(" *   gen_dissolve_order\n");
+	printf(" */\n");
+	
+	printf("PROGMEM prog_uchar DISSOLVE_ORDER[%d] = {\n", NUM_PIXELS);
+	for (int i = 0; i < NUM_PIXELS; i++)
+		printf("%s%3d,%s", (i % 12 == 0) ? "\t" : " ", order[i],
+		       (i % 12 == 11 || i == NUM_PIXELS - 1) ? "\n" : "");
+	printf("};\n");
+	
+	return 0;
+}
@@ -0,0 +1,107 @@
+/**
+ * Generates face_table.h: every face face() can draw (each happiness, with the
+ * eyes open and blinking) precomposed from the component bitmaps by the
+ * firmware's own face_compose(), so that drawing a face is a single copy.
+ *
+ * Usage:
+ *
+ *   gen_faces > ../word_clock/face_table.h
+ *
+ * Identical faces (e.g. the blinking faces, whose eyes hide any differences
+ * between the eyes at different happinesses, where the mouths also match) are
+ * stored once. The faces are cropped to the rows lit in any face (FACE_TOP to
+ * FACE_TOP + FACE_NUM_ROWS - 1) and each row is stored as an index into a pool
+ * of the distinct rows, FACE_ROWS.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <vector>
+
+#include <Arduino.h>
+
+#include "word_clock.h"
+#include "frame.h"
+#include "face.h"
+
+#include "asset_pack.h"
+
+#define NUM_HAPPINESSES (1 + (FACE_MAX) - (FACE_MIN))
+
+
+int main(int argc, char *argv[]) {
+	std::vector<frame_t> frames;
+	int index[2][NUM_HAPPINESSES];
+	
+	for (int blink = 0; blink < 2; blink++) {
+		for (int happiness = FACE_MIN; happiness <= FACE_MAX; happiness++) {
+			frame_t buf;
+			face_compose(&buf, happiness, blink);
+			
+			size_t i;
+			for (i = 0; i < frames.size(); i++)
+				if (memcmp(&frames[i], &buf, sizeof(buf)) == 0)
+					break;
+			if (i == frames.size())
+				frames.push_back(buf);
+			index[blink][happiness - FACE_MIN] = i;
+		}
+	}
+	
+	if (frames.size() > 256) {
+		fprintf(stderr, "ERROR: Too many faces to index with a byte\n");
+		return 1;
+	}
+	
+	// Crop to the rows lit in any face
+	int top = HEIGHT;
+	int bottom = -1;
+	for (size_t i = 0; i < frames.size(); i++) {
+		for (int y = 0; y < HEIGHT; y++) {
+			if (frames[i].rows[y]) {
+				top = (y < top) ? y : top;
+				bottom = (y > bottom) ? y : bottom;
+			}
+		}
+	}
+	if (bottom < top)
+		top = bottom = 0;
+	int num_rows = 1 + bottom - top;
+	
+	line_pool_t rows;
+	std::vector<std::vector<int> > frame_rows(frames.size());
+	for (size_t i = 0; i < frames.size(); i++)
+		for (int y = top; y <= bottom; y++)
+			frame_rows[i].push_back(line_pool_index(&rows, frames[i].rows[y]));
+	
+	printf("/**\n");
+	printf(" * Automatically-generated packed precomposed face table.\n");
+	printf(" *   gen_faces\n");
+	printf(" */\n");
+	
+	printf("#define FACE_TOP %d\n", top);
+	printf("#define FACE_NUM_ROWS %d\n", num_rows);
+	
+	line_pool_print(&rows, "FACE_ROWS", WIDTH, true);
+	
+	printf("PROGMEM prog_uchar FACE_FRAMES[%zu][FACE_NUM_ROWS] = {\n", frames.size());
+	for (size_t i = 0; i < frames.size(); i++) {
+		printf("\t{");
+		for (int y = 0; y < num_rows; y++)
+			printf("%s%2d", y ? ", " : "", frame_rows[i][y]);
+		printf("},\n");
+	}
+	printf("};\n");
+	
+	printf("PROGMEM prog_uchar FACE_INDEX[2][%d] = {\n", NUM_HAPPINESSES);
+	for (int blink = 0; blink < 2; blink++) {
+		printf("\t{ // %s\n", blink ? "Blinking" : "Eyes open");
+		for (int happiness = FACE_MIN; happiness <= FACE_MAX; happiness++)
+			printf("\t\t%3d, // %d\n", index[blink][happiness - FACE_MIN], happiness);
+		printf("\t},\n");
+	}
+	printf("};\n");
+	
+	return 0;
+}
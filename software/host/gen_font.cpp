@@ -0,0 +1,167 @@
+/**
+ * Generates font_table.h: the font produced by util/font_gen.py (font.h)
+ * packed for the text renderer.
+ *
+ * Usage:
+ *
+ *   gen_font > ../word_clock/font_table.h
+ *
+ * font.h stores every column of every glyph as FONT_HEIGHT bits, padded to a
+ * whole number of bytes. Here glyphs are centred on the display as the text
+ * renderer shows them and cropped to the display's HEIGHT rows, with the top
+ * row in bit 0. Trailing blank columns are dropped (columns beyond those
+ * stored are blank) and each column is stored as an index into a pool of the
+ * distinct columns, FONT_COLUMNS. The ASCII lookup table is cropped to the
+ * range of characters in the font.
+ */
+
+#include <stdio.h>
+
+#include <vector>
+
+#include <Arduino.h>
+
+#include "word_clock.h"
+
+#include "font.h"
+
+#include "asset_pack.h"
+
+#if HEIGHT > 16
+	#error "Font columns no longer fit in a word"
+#endif
+
+
+/**
+ * Print a character for use in a comment.
+ */
+static void print_char(int c) {
+	if (c >= ' ' && c <= '~')
+		printf("'%c'", c);
+	else
+		printf("0x%02X", c);
+}
+
+
+/**
+ * Get a column of a glyph as it appears on the display, top row in bit 0.
+ */
+static uint16_t glyph_column(int index, int col) {
+	const int bytes_per_col = FONT_HEIGHT / 8;
+	const prog_uchar *data = FONT_GLYPH_BITMAPS
+	                       + FONT_GLYPH_BITMAPS_LOOKUP[index]
+	                       + (col * bytes_per_col);
+	
+	uint16_t column = 0;
+	for (int y = 0; y < HEIGHT; y++) {
+		int font_row = y - (((int)HEIGHT - (int)FONT_HEIGHT) / 2);
+		if (font_row >= 0 && font_row < (int)FONT_HEIGHT
+		    && (data[font_row / 8] >> (7 - (font_row % 8))) & 1)
+			column |= 1u << y;
+	}
+	return column;
+}
+
+
+int main(int argc, char *argv[]) {
+	int num_chars = FONT_NUM_CHARS;
+	
+	// The range of characters in the font
+	int first_char = -1;
+	int last_char = -1;
+	for (int c = 0; c < 128; c++) {
+		if (FONT_ASCII_TO_INDEX[c] != 0xFF) {
+			if (first_char < 0)
+				first_char = c;
+			last_char = c;
+		}
+	}
+	if (first_char < 0 || FONT_ASCII_TO_INDEX[' '] == 0xFF) {
+		fprintf(stderr, "ERROR: The font must include a space\n");
+		return 1;
+	}
+	
+	// Pack the glyphs' columns
+	line_pool_t columns;
+	std::vector<std::vector<int> > glyph_columns(num_chars);
+	for (int i = 0; i < num_chars; i++) {
+		int width = FONT_GLYPH_WIDTH[i];
+		while (width > 0 && glyph_column(i, width - 1) == 0)
+			width--;
+		for (int col = 0; col < width; col++)
+			glyph_columns[i].push_back(line_pool_index(&columns, glyph_column(i, col)));
+	}
+	
+	// The character represented by each glyph
+	std::vector<int> glyph_chars(num_chars, -1);
+	for (int c = 0; c < 128; c++)
+		if (FONT_ASCII_TO_INDEX[c] != 0xFF)
+			glyph_chars[FONT_ASCII_TO_INDEX[c]] = c;
+	
+	printf("/**\n");
+	printf(" * Automatically-generated packed font.\n");
+	printf(" *   gen_font\n");
+	printf(" */\n");
+	
+	printf("#define FONT_FIRST_CHAR 0x%02X\n", first_char);
+	printf("#define FONT_LAST_CHAR 0x%02X\n", last_char);
+	printf("#define FONT_DEFAULT_INDEX %d // ' '\n", FONT_ASCII_TO_INDEX[' ']);
+	
+	// The most columns stored for any glyph
+	size_t max_columns = 0;
+	for (int i = 0; i < num_chars; i++)
+		max_columns = (glyph_columns[i].size() > max_columns) ? glyph_columns[i].size() : max_columns;
+	printf("#define FONT_MAX_COLUMNS %zu\n", max_columns);
+	
+	printf("PROGMEM prog_uchar FONT_ASCII_TO_INDEX[%d] = {\n", 1 + last_char - first_char);
+	for (int c = first_char; c <= last_char; c++) {
+		printf("\t0x%02X, // ", FONT_ASCII_TO_INDEX[c]);
+		print_char(c);
+		printf("\n");
+	}
+	printf("};\n");
+	
+	line_pool_print(&columns, "FONT_COLUMNS", HEIGHT, false);
+	
+	size_t num_glyph_columns = 0;
+	for (int i = 0; i < num_chars; i++)
+		num_glyph_columns += glyph_columns[i].size();
+	printf("PROGMEM prog_uchar FONT_GLYPH_COLUMNS[%zu] = {\n", num_glyph_columns);
+	for (int i = 0; i < num_chars; i++) {
+		if (glyph_columns[i].empty())
+			continue;
+		printf("\t");
+		for (size_t col = 0; col < glyph_columns[i].size(); col++)
+			printf("%3d,", glyph_columns[i][col]);
+		printf(" // ");
+		print_char(glyph_chars[i]);
+		printf("\n");
+	}
+	printf("};\n");
+	
+	// Glyph i's columns run up to the start of glyph i+1's
+	printf("PROGMEM prog_uint16_t FONT_GLYPH_COLUMNS_LOOKUP[%d] = {\n", num_chars + 1);
+	size_t offset = 0;
+	for (int i = 0; i < num_chars; i++) {
+		printf("\t%3zu, // ", offset);
+		print_char(glyph_chars[i]);
+		printf("\n");
+		offset += glyph_columns[i].size();
+	}
+	printf("\t%3zu,\n", offset);
+	printf("};\n");
+	
+	const char *names[] = {"WIDTH", "START", "END"};
+	const prog_uchar *tables[] = {FONT_GLYPH_WIDTH, FONT_GLYPH_START, FONT_GLYPH_END};
+	for (int t = 0; t < 3; t++) {
+		printf("PROGMEM prog_uchar FONT_GLYPH_%s[%d] = {\n", names[t], num_chars);
+		for (int i = 0; i < num_chars; i++) {
+			printf("\t%2d, // ", tables[t][i]);
+			print_char(glyph_chars[i]);
+			printf("\n");
+		}
+		printf("};\n");
+	}
+	
+	return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * Generates time_mask_table.h: a table of the word masks which show the time
+ * on the clock face, produced by running the firmware's own string builder and
+ * word mask matcher for every minute of the day.
+ *
+ * Usage:
+ *
+ *   gen_time_masks > ../word_clock/time_mask_table.h
+ *
+ * The words are placed right-to-left so the position of each word depends only
+ * on the words following it. Every mask is thus split into an hour part (the
+ * hour and am/pm) and a minute part ("it is", the minutes and past/to) which
+ * are stored separately and ORed together at runtime. The generator checks
+ * this decomposition reproduces the matcher's output for every time of day.
+ *
+ * Each part is stored as a list of (row, row bits) entries terminated by a row
+ * of 0xFF. Lists which end with the same entries share storage.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <string>
+#include <vector>
+
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
+#include "word_clock.h"
+#include "frame.h"
+#include "strbuf.h"
+#include "words.h"
+
+#define END_OF_MASK 0xFF
+
+// A mask as a list of (row, bits) entries (excluding the terminator)
+typedef std::vector<std::pair<int, frame_row_t> > entries_t;
+
+static entries_t to_entries(const frame_t *buf) {
+	entries_t entries;
+	for (int y = HEIGHT - 1; y >= 0; y--)
+		if (buf->rows[y])
+			entries.push_back(std::make_pair(y, buf->rows[y]));
+	return entries;
+}
+
+/**
+ * Get the relative hour (i.e. the hour named) for a given time.
+ */
+static int relative_hour(int hours, int minutes) {
+	return (minutes <= 30) ? hours : (hours + 1) % 24;
+}
+
+/**
+ * Produce the mask for "it is <time>" exactly as the clock would at runtime.
+ */
+static void time_phrase(char *str, size_t size, frame_t *buf, int hours, int minutes) {
+	strbuf_t sb;
+	strbuf_init(&sb, str, size);
+	strbuf_append_P(&sb, PSTR("it is "));
+	words_append_time(&sb, hours, minutes);
+	if (!words_set_mask(buf, str)) {
+		fprintf(stderr, "ERROR: Cannot display '%s'\n", str);
+		exit(1);
+	}
+}
+
+
+int main(int argc, char *argv[]) {
+	static frame_t masks[24][60];
+	static char phrases[24][60][100];
+	for (int h = 0; h < 24; h++)
+		for (int m = 0; m < 60; m++)
+			time_phrase(phrases[h][m], sizeof(phrases[h][m]), &masks[h][m], h, m);
+	
+	// The hour part of each mask: for a time on the hour, everything but "it is"
+	frame_t hour_parts[24];
+	std::string hour_names[24];
+	for (int rh = 0; rh < 24; rh++) {
+		char str[100];
+		strbuf_t sb;
+		strbuf_init(&sb, str, sizeof(str));
+		words_append_time(&sb, rh, 0);
+		words_set_mask(&hour_parts[rh], str);
+		hour_names[rh] = str;
+	}
+	
+	// The minute part of each mask: whatever remains
+	frame_t minute_parts[60];
+	std::string minute_names[60];
+	for (int m = 0; m < 60; m++) {
+		int h = (m <= 30) ? 0 : 23;
+		const frame_t *hour_part = &hour_parts[relative_hour(h, m)];
+		for (int y = 0; y < HEIGHT; y++)
+			minute_parts[m].rows[y] = masks[h][m].rows[y] & ~hour_part->rows[y];
+		
+		minute_names[m] = phrases[h][m];
+		minute_names[m].resize(minute_names[m].size() - hour_names[relative_hour(h, m)].size());
+	}
+	
+	// Check the decomposition is exact for every time
+	for (int h = 0; h < 24; h++) {
+		for (int m = 0; m < 60; m++) {
+			const frame_t *hour_part = &hour_parts[relative_hour(h, m)];
+			for (int y = 0; y < HEIGHT; y++) {
+				if ((hour_part->rows[y] | minute_parts[m].rows[y]) != masks[h][m].rows[y]
+				    || (hour_part->rows[y] & minute_parts[m].rows[y])) {
+					fprintf(stderr, "ERROR: '%s' cannot be split into hour and minute parts\n",
+					        phrases[h][m]);
+					return 1;
+				}
+			}
+		}
+	}
+	
+	// Lay out the entry lists longest first so that shorter lists can share the
+	// tail of a longer one.
+	std::vector<entries_t> lists;
+	std::vector<std::string> names;
+	for (int rh = 0; rh < 24; rh++) {
+		lists.push_back(to_entries(&hour_parts[rh]));
+		names.push_back(hour_names[rh]);
+	}
+	for (int m = 0; m < 60; m++) {
+		lists.push_back(to_entries(&minute_parts[m]));
+		names.push_back(minute_names[m]);
+	}
+	
+	std::vector<size_t> order;
+	for (size_t i = 0; i < lists.size(); i++)
+		order.push_back(i);
+	for (size_t i = 0; i < order.size(); i++)
+		for (size_t j = i + 1; j < order.size(); j++)
+			if (lists[order[j]].size() > lists[order[i]].size())
+				std::swap(order[i], order[j]);
+	
+	// The entries stored (each followed by a terminator) and the offset (in
+	// bytes) of every list.
+	std::vector<entries_t> stored;
+	std::vector<size_t> stored_offsets;
+	std::vector<size_t> offsets(lists.size());
+	size_t num_bytes = 0;
+	for (size_t n = 0; n < order.size(); n++) {
+		const entries_t &list = lists[order[n]];
+		bool found = false;
+		for (size_t s = 0; s < stored.size() && !found; s++) {
+			if (stored[s].size() >= list.size()
+			    && std::equal(list.begin(), list.end(), stored[s].end() - list.size())) {
+				offsets[order[n]] = stored_offsets[s] + 3 * (stored[s].size() - list.size());
+				found = true;
+			}
+		}
+		if (!found) {
+			stored.push_back(list);
+			stored_offsets.push_back(num_bytes);
+			offsets[order[n]] = num_bytes;
+			num_bytes += 3 * list.size() + 1;
+		}
+	}
+	
+	printf("/**\n");
+	printf(" * Automatically-generated time mask table.\n");
+	printf(" *   gen_time_masks\n");
+	printf(" */\n");
+	
+	printf("PROGMEM prog_uchar TIME_MASK_DATA[%zu] = {\n", num_bytes);
+	for (size_t s = 0; s < stored.size(); s++) {
+		for (size_t e = 0; e < stored[s].size(); e++)
+			printf("\t%2d, 0x%02X, 0x%02X,\n",
+			       stored[s][e].first,
+			       stored[s][e].second >> 8,
+			       stored[s][e].second & 0xFF);
+		printf("\t0x%02X,\n", END_OF_MASK);
+	}
+	printf("};\n");
+	
+	printf("PROGMEM prog_uint16_t TIME_MASK_HOURS[24] = {\n");
+	for (int rh = 0; rh < 24; rh++)
+		printf("\t%4zu, // '%s'\n", offsets[rh], names[rh].c_str());
+	printf("};\n");
+	
+	printf("PROGMEM prog_uint16_t TIME_MASK_MINUTES[60] = {\n");
+	for (int m = 0; m < 60; m++)
+		printf("\t%4zu, // '%s'\n", offsets[24 + m], names[24 + m].c_str());
+	printf("};\n");
+	
+	return 0;
+}
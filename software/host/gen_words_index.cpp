@@ -0,0 +1,60 @@
+/**
+ * Generates words_index.h: for each letter which may appear in the letter mask,
+ * the list of cells containing it in descending order. This allows
+ * words_set_mask to jump straight to candidate positions for a word rather
+ * than scanning the whole mask.
+ *
+ * Usage:
+ *
+ *   gen_words_index > ../word_clock/words_index.h
+ */
+
+#include <stdio.h>
+
+#include <vector>
+
+#include <Arduino.h>
+
+#include "word_clock.h"
+#include "words_grid.h"
+
+
+int main(int argc, char *argv[]) {
+	std::vector<int> cells[WORDS_NUM_LETTER_SLOTS];
+	for (int cell = (HEIGHT*WIDTH) - 1; cell >= 0; cell--) {
+		char c = GET_MASK_CELL(cell);
+		int slot = WORDS_LETTER_SLOT(c);
+		if (slot < 0) {
+			fprintf(stderr, "ERROR: '%c' in the letter mask has no slot\n", c);
+			return 1;
+		}
+		cells[slot].push_back(cell);
+	}
+	
+	printf("/**\n");
+	printf(" * Automatically-generated letter mask index.\n");
+	printf(" *   gen_words_index\n");
+	printf(" */\n");
+	
+	printf("PROGMEM prog_uchar WORDS_INDEX_START[%d] = {\n", WORDS_NUM_LETTER_SLOTS + 1);
+	int start = 0;
+	for (int slot = 0; slot < WORDS_NUM_LETTER_SLOTS; slot++) {
+		printf("\t%3d, // '%c'\n", start, slot < 26 ? 'a' + slot : '*');
+		start += cells[slot].size();
+	}
+	printf("\t%3d,\n", start);
+	printf("};\n");
+	
+	printf("PROGMEM prog_uchar WORDS_INDEX_CELLS[%d] = {\n", start);
+	for (int slot = 0; slot < WORDS_NUM_LETTER_SLOTS; slot++) {
+		if (cells[slot].empty())
+			continue;
+		printf("\t");
+		for (size_t i = 0; i < cells[slot].size(); i++)
+			printf("%3d,%s", cells[slot][i], (i + 1 < cells[slot].size()) ? " " : "");
+		printf(" // '%c'\n", slot < 26 ? 'a' + slot : '*');
+	}
+	printf("};\n");
+	
+	return 0;
+}
@@ -0,0 +1,170 @@
+/**
+ * Runs the word clock firmware against simulated hardware on a Linux host.
+ *
+ * Usage:
+ *
+ *   word_clock_sim [-s seconds] [-t unix_time] [-l loop_usec] [-k shake_at]
+ *                  [-a ldr_level] [-f]
+ *
+ *   -s  Duration of virtual time to simulate (default: 60 seconds).
+ *   -t  Initial RTC time as seconds since the epoch (default: 2015-01-04
+ *       12:00:00, our first aniversary).
+ *   -l  Virtual time taken by each iteration of loop(), on top of any SPI
+ *       transfers (default: 100 usec).
+ *   -k  Shake the clock (wiggle the tilt switches) starting at the given
+ *       number of seconds in.
+ *   -a  Ambient level seen by the LDR (default: 512).
+ *   -f  Print the display's contents every time it changes.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <Arduino.h>
+
+#include "word_clock.h"
+#include "sim.h"
+#include "max7219.h"
+#include "display.h"
+#include "frame_sched.h"
+#include "grey.h"
+#include "ldr_sampler.h"
+
+// Defined by the firmware
+void setup(void);
+void loop(void);
+
+// Duration of a simulated shake (usec)
+#define SHAKE_DURATION_US 3000000ull
+
+// Time between tilt switch changes during a shake (usec)
+#define SHAKE_PERIOD_US 100000ull
+
+
+/**
+ * Capture the display's current contents as a string (lit pixels are drawn
+ * using their intensity as a hex digit).
+ */
+static void snapshot(char *out) {
+	for (int y = 0; y < HEIGHT; y++) {
+		for (int x = 0; x < WIDTH; x++) {
+			if (max7219_pixel(x, y))
+				*(out++) = "0123456789ABCDEF"[max7219_intensity(x, y)];
+			else
+				*(out++) = '.';
+		}
+		*(out++) = '\n';
+	}
+	*out = '\0';
+}
+
+
+int main(int argc, char *argv[]) {
+	double duration_s = 60.0;
+	time_t start_time = 1420372800; // 2015-01-04 12:00:00
+	unsigned long loop_us = 100;
+	double shake_at_s = -1.0;
+	int ambient = 512;
+	bool print_frames = false;
+	
+	int opt;
+	while ((opt = getopt(argc, argv, "s:t:l:k:a:f")) != -1) {
+		switch (opt) {
+			case 's': duration_s = atof(optarg); break;
+			case 't': start_time = (time_t)atoll(optarg); break;
+			case 'l': loop_us = strtoul(optarg, NULL, 10); break;
+			case 'k': shake_at_s = atof(optarg); break;
+			case 'a': ambient = atoi(optarg); break;
+			case 'f': print_frames = true; break;
+			default:
+				fprintf(stderr, "Usage: %s [-s seconds] [-t unix_time] [-l loop_usec] "
+				                "[-k shake_at] [-a ldr_level] [-f]\n", argv[0]);
+				return 1;
+		}
+	}
+	
+	sim_begin(start_time);
+	sim_set_analog(LDR_PIN, ambient);
+	
+	unsigned long long end_us = (unsigned long long)(duration_s * 1e6);
+	unsigned long long shake_us = (unsigned long long)(shake_at_s * 1e6);
+	
+	static char last_frame[(WIDTH + 1) * HEIGHT + 1] = "";
+	static char frame[(WIDTH + 1) * HEIGHT + 1];
+	unsigned long long loops = 0ull;
+	unsigned long frame_changes = 0ul;
+	
+	// SPI traffic accounting: the number of loop iterations which sent anything
+	// to the displays and the worst case cost of a single iteration.
+	unsigned long long spi_loops = 0ull;
+	unsigned long max_loop_bytes = 0ul;
+	unsigned long long max_loop_wire_ns = 0ull;
+	max7219_stats_t before, after;
+	
+	setup();
+	while (sim_time_us() < end_us) {
+		// Shake the device by wiggling the tilt switches out of phase
+		if (shake_at_s >= 0.0 && sim_time_us() >= shake_us
+		    && sim_time_us() < shake_us + SHAKE_DURATION_US) {
+			bool phase = ((sim_time_us() - shake_us) / SHAKE_PERIOD_US) & 1;
+			sim_set_digital(TILT_LEFT_PIN, phase);
+			sim_set_digital(TILT_RIGHT_PIN, !phase);
+		}
+		
+		// Bytes are sent in the background by the SPI interrupt so the whole
+		// iteration, including the time following loop(), is accounted for.
+		max7219_get_stats(&before);
+		loop();
+		loops++;
+		sim_advance_us(loop_us);
+		max7219_get_stats(&after);
+		
+		unsigned long loop_bytes = after.bytes - before.bytes;
+		if (loop_bytes) {
+			spi_loops++;
+			if (loop_bytes > max_loop_bytes)
+				max_loop_bytes = loop_bytes;
+			if (after.wire_ns - before.wire_ns > max_loop_wire_ns)
+				max_loop_wire_ns = after.wire_ns - before.wire_ns;
+		}
+		
+		// Only look at whole frames, not those part-way through being sent
+		if (display_busy())
+			continue;
+		
+		snapshot(frame);
+		if (strcmp(frame, last_frame) != 0) {
+			frame_changes++;
+			if (print_frames)
+				printf("t=%.6f\n%s\n", sim_time_us() / 1e6, frame);
+			strcpy(last_frame, frame);
+		}
+	}
+	
+	printf("Simulated %.3f s in %llu loop iterations, display changed %lu times.\n",
+	       sim_time_us() / 1e6, loops, frame_changes);
+	
+	max7219_stats_t stats;
+	max7219_get_stats(&stats);
+	printf("SPI: %lu bytes, %lu latches (%lu misaligned), %.3f ms on the wire.\n",
+	       stats.bytes, stats.latches, stats.misaligned_latches, stats.wire_ns / 1e6);
+	printf("SPI: %llu loop iterations sent data, worst %lu bytes / %.1f us.\n",
+	       spi_loops, max_loop_bytes, max_loop_wire_ns / 1e3);
+	printf("SPI: register writes:");
+	for (int reg = 0; reg < 16; reg++)
+		if (stats.writes[reg])
+			printf(" 0x%X=%lu", reg, stats.writes[reg]);
+	printf("\n");
+	
+	frame_sched_stats_t sched;
+	frame_sched_get_stats(&sched);
+	printf("Frames: %lu rendered, %lu overran, %lu skipped, longest %lu us, "
+	       "least slack %lu us.\n",
+	       sched.frames, sched.overruns, sched.skipped, sched.max_frame_time,
+	       sched.min_slack);
+	printf("Grey: %lu bit-planes shown late.\n", grey_late_planes());
+	printf("LDR: %lu samples dropped.\n", ldr_sampler_dropped());
+	
+	return 0;
+}
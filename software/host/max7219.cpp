@@ -0,0 +1,214 @@
+#include <string.h>
+
+#include "max7219.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Register addresses
+////////////////////////////////////////////////////////////////////////////////
+
+#define REG_NOP          0x0
+#define REG_DIGIT0       0x1
+#define REG_DIGIT7       0x8
+#define REG_DECODE_MODE  0x9
+#define REG_INTENSITY    0xA
+#define REG_SCAN_LIMIT   0xB
+#define REG_SHUTDOWN     0xC
+#define REG_TEST         0xF
+
+// Segment patterns (bit 6 = segment A ... bit 0 = segment G) produced for each
+// digit value in Code B decode mode: 0-9, '-', 'E', 'H', 'L', 'P' and blank.
+static const uint8_t CODE_B[16] = {
+	0x7E, 0x30, 0x6D, 0x79, 0x33, 0x5B, 0x5F, 0x70,
+	0x7F, 0x7B, 0x01, 0x4F, 0x37, 0x0E, 0x67, 0x00,
+};
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Chain state
+////////////////////////////////////////////////////////////////////////////////
+
+typedef struct {
+	// The 16-bit shift register
+	uint16_t shift;
+	
+	// Registers
+	uint8_t digits[8];
+	uint8_t decode_mode;
+	uint8_t intensity;
+	uint8_t scan_limit;
+	bool shutdown;
+	bool test;
+} chip_t;
+
+// Chips in scan-path order: chip 0 is the first chip data is shifted into.
+static chip_t chips[MAX7219_NUM_CHIPS];
+
+// The orientation of each chip's display (in scan-path order)
+static const uint8_t ORIENTATIONS[MAX7219_NUM_CHIPS] = DISPLAY_ORIENTATIONS;
+
+// Last level of the LOAD line
+static bool load_level;
+
+// Number of bits shifted in since the last latch
+static unsigned long bits_since_latch;
+
+// Serial clock frequency (Hz)
+static unsigned long sck_hz;
+
+static max7219_stats_t stats;
+
+
+/**
+ * Get the chip (and column/row within it) responsible for a given pixel.
+ */
+static const chip_t *pixel_chip(int x, int y, int *col, int *row) {
+	int display_x = x / DISPLAY_WIDTH;
+	int display_y = y / DISPLAY_HEIGHT;
+	
+	// Walk the scan path (see word_clock.h) until reaching the display. Lines
+	// are the rows (or columns) of displays the path runs along.
+	int line_length = DISPLAY_CHAIN_COLUMNS ? DISPLAYS_Y : DISPLAYS_X;
+	int index = 0;
+	for (int line = 0; line < MAX7219_NUM_CHIPS / line_length; line++) {
+		for (int along = 0; along < line_length; along++, index++) {
+			bool reversed = DISPLAY_CHAIN_SERPENTINE && (line % 2 == 1);
+			int from_start = reversed ? line_length - 1 - along : along;
+			int cx = DISPLAY_CHAIN_COLUMNS ? line : from_start;
+			int cy = DISPLAY_CHAIN_COLUMNS ? from_start : line;
+			if (DISPLAY_CHAIN_FROM_RIGHT)
+				cx = DISPLAYS_X - 1 - cx;
+			if (DISPLAY_CHAIN_FROM_BOTTOM)
+				cy = DISPLAYS_Y - 1 - cy;
+			if (cx == display_x && cy == display_y)
+				goto found;
+		}
+	}
+	found:
+	
+	*col = x % DISPLAY_WIDTH;
+	*row = y % DISPLAY_HEIGHT;
+	if (ORIENTATIONS[index] & DISPLAY_MIRROR_X)
+		*col = DISPLAY_WIDTH - 1 - *col;
+	if (ORIENTATIONS[index] & DISPLAY_MIRROR_Y)
+		*row = DISPLAY_HEIGHT - 1 - *row;
+	
+	return &chips[index];
+}
+
+
+/**
+ * The segments (columns) lit for a given digit (row) of a chip, taking the
+ * decode mode into account.
+ */
+static uint8_t digit_segments(const chip_t *chip, int digit) {
+	uint8_t value = chip->digits[digit];
+	if (chip->decode_mode & (1 << digit))
+		return (value & 0x80) | CODE_B[value & 0xF];
+	else
+		return value;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////////
+
+void max7219_reset(void) {
+	// Registers power up blank and in shutdown
+	memset(chips, 0, sizeof(chips));
+	for (int i = 0; i < MAX7219_NUM_CHIPS; i++)
+		chips[i].shutdown = true;
+	load_level = true;
+	bits_since_latch = 0ul;
+	
+	// SPI_CLOCK_DIV4 at 16 MHz is the Arduino SPI library's default
+	sck_hz = 4000000ul;
+	
+	max7219_reset_stats();
+}
+
+
+void max7219_set_sck_hz(unsigned long hz) {
+	sck_hz = hz;
+}
+
+
+unsigned long max7219_shift(uint8_t data) {
+	// The chips form one long shift register: the top byte of each chip moves
+	// into the next chip along the chain.
+	for (int i = MAX7219_NUM_CHIPS - 1; i > 0; i--)
+		chips[i].shift = (chips[i].shift << 8) | (chips[i-1].shift >> 8);
+	chips[0].shift = (chips[0].shift << 8) | data;
+	
+	bits_since_latch += 8;
+	
+	unsigned long ns = (8ul * 1000000000ul) / sck_hz;
+	stats.bytes++;
+	stats.wire_ns += ns;
+	return ns;
+}
+
+
+void max7219_load(bool level) {
+	if (level && !load_level) {
+		stats.latches++;
+		if (bits_since_latch != 16ul * MAX7219_NUM_CHIPS)
+			stats.misaligned_latches++;
+		bits_since_latch = 0ul;
+		
+		for (int i = 0; i < MAX7219_NUM_CHIPS; i++) {
+			chip_t *chip = &chips[i];
+			int reg = (chip->shift >> 8) & 0xF;
+			uint8_t value = chip->shift & 0xFF;
+			
+			stats.writes[reg]++;
+			
+			if (reg >= REG_DIGIT0 && reg <= REG_DIGIT7)
+				chip->digits[reg - REG_DIGIT0] = value;
+			else if (reg == REG_DECODE_MODE)
+				chip->decode_mode = value;
+			else if (reg == REG_INTENSITY)
+				chip->intensity = value & 0xF;
+			else if (reg == REG_SCAN_LIMIT)
+				chip->scan_limit = value & 0x7;
+			else if (reg == REG_SHUTDOWN)
+				chip->shutdown = !(value & 0x1);
+			else if (reg == REG_TEST)
+				chip->test = value & 0x1;
+		}
+	}
+	load_level = level;
+}
+
+
+bool max7219_pixel(int x, int y) {
+	int col, row;
+	const chip_t *chip = pixel_chip(x, y, &col, &row);
+	
+	// Display test overrides shutdown and lights everything
+	if (chip->test)
+		return true;
+	
+	if (chip->shutdown || row > chip->scan_limit)
+		return false;
+	
+	return digit_segments(chip, row) & (0x80 >> col);
+}
+
+
+int max7219_intensity(int x, int y) {
+	int col, row;
+	const chip_t *chip = pixel_chip(x, y, &col, &row);
+	return chip->test ? 0xF : chip->intensity;
+}
+
+
+void max7219_get_stats(max7219_stats_t *out) {
+	*out = stats;
+}
+
+
+void max7219_reset_stats(void) {
+	memset(&stats, 0, sizeof(stats));
+}
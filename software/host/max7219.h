@@ -0,0 +1,88 @@
+/**
+ * An emulator of the chain of MAX7219/MAX7221 display drivers as wired up in
+ * the word clock (see word_clock.h for the scan path).
+ *
+ * Every register write shifted into the chain is decoded (no-op, digits,
+ * decode mode, intensity, scan limit, shutdown and display test) and the
+ * visible image is reconstructed from the resulting register state. Traffic
+ * is counted and timed at the configured SPI clock so the cost of each frame
+ * sent can be measured.
+ */
+
+#ifndef MAX7219_H
+#define MAX7219_H
+
+#include <stdint.h>
+
+#include "word_clock.h"
+
+#define MAX7219_NUM_CHIPS ((DISPLAYS_X) * (DISPLAYS_Y))
+
+/**
+ * Counters of the traffic seen by the chain.
+ */
+typedef struct {
+	// Number of bytes shifted into the chain
+	unsigned long bytes;
+	
+	// Number of rising edges on the LOAD line
+	unsigned long latches;
+	
+	// Number of rising edges on the LOAD line which occurred after other than
+	// exactly one 16-bit word per chip had been shifted in (i.e. stale data was
+	// latched into some chips).
+	unsigned long misaligned_latches;
+	
+	// Number of latched writes to each register address (per chip), including
+	// no-ops.
+	unsigned long writes[16];
+	
+	// Time spent clocking data into the chain (nsec)
+	unsigned long long wire_ns;
+} max7219_stats_t;
+
+
+/**
+ * Reset every chip in the chain to its power-on state and zero the stats.
+ */
+void max7219_reset(void);
+
+/**
+ * Set the frequency of the serial clock (Hz) used to time shifted data.
+ */
+void max7219_set_sck_hz(unsigned long hz);
+
+/**
+ * Shift a byte into the start of the scan path (MSB first).
+ *
+ * @returns The time taken to clock the byte in (nsec).
+ */
+unsigned long max7219_shift(uint8_t data);
+
+/**
+ * Set the level of the shared LOAD/nCS line. The contents of each chip's shift
+ * register are latched into its registers on a rising edge.
+ */
+void max7219_load(bool level);
+
+/**
+ * Is the given pixel currently lit?
+ */
+bool max7219_pixel(int x, int y);
+
+/**
+ * Get the intensity register of the display containing the given pixel.
+ */
+int max7219_intensity(int x, int y);
+
+/**
+ * Get the traffic counters accumulated since the last reset.
+ */
+void max7219_get_stats(max7219_stats_t *stats);
+
+/**
+ * Zero the traffic counters (the chips' state is unaffected).
+ */
+void max7219_reset_stats(void);
+
+#endif
@@ -0,0 +1,322 @@
+#include <stdint.h>
+#include <string.h>
+
+#include <Arduino.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "sim.h"
+#include "max7219.h"
+#include "word_clock.h"
+
+#define NUM_PINS 20
+
+////////////////////////////////////////////////////////////////////////////////
+// Simulated hardware state
+////////////////////////////////////////////////////////////////////////////////
+
+// Virtual time (nsec)
+static unsigned long long time_ns;
+
+static int  analog_in[NUM_PINS];
+static bool digital_in[NUM_PINS];
+static bool digital_out[NUM_PINS];
+
+// RTC time at sim_time_us() == rtc_set_us
+static time_t rtc_time;
+static unsigned long long rtc_set_us;
+
+// Is the SPI transfer complete interrupt enabled?
+static bool spi_interrupt_enabled;
+
+// Is a byte written to SPDR still being clocked out and, if so, when will it
+// have finished?
+static bool spi_busy;
+static unsigned long long spi_done_ns;
+
+// Is Timer1 running and, if so, when is its next compare match?
+static bool timer1_running;
+static unsigned long long timer1_match_ns;
+
+// Likewise for Timer2
+static bool timer2_running;
+static unsigned long long timer2_match_ns;
+
+// AVR registers
+volatile uint8_t  SREG;
+volatile uint8_t  TCCR1A;
+volatile uint8_t  TCCR1B;
+volatile uint16_t TCNT1;
+volatile uint16_t OCR1A;
+volatile uint16_t OCR1B;
+volatile uint8_t  TIMSK1;
+SimFlagRegister   TIFR1;
+volatile uint8_t  TCCR2A;
+volatile uint8_t  TCCR2B;
+volatile uint8_t  TCNT2;
+volatile uint8_t  OCR2A;
+volatile uint8_t  TIMSK2;
+SimFlagRegister   TIFR2;
+volatile uint8_t  ADMUX;
+volatile uint8_t  ADCSRA;
+volatile uint8_t  ADCSRB;
+volatile uint16_t ADC;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Internal functions
+////////////////////////////////////////////////////////////////////////////////
+
+int sim_analog_read(int pin);
+
+/**
+ * The time between Timer1 compare matches according to its registers, or 0 if
+ * it is stopped.
+ */
+static unsigned long long timer1_period_ns(void) {
+	unsigned long long prescale;
+	switch (TCCR1B & (_BV(CS12) | _BV(CS11) | _BV(CS10))) {
+		case 1:  prescale = 1ull;    break;
+		case 2:  prescale = 8ull;    break;
+		case 3:  prescale = 64ull;   break;
+		case 4:  prescale = 256ull;  break;
+		case 5:  prescale = 1024ull; break;
+		default: return 0ull;
+	}
+	
+	// Only clear-timer-on-compare (with OCR1A as TOP) is supported
+	if ((TCCR1B & _BV(WGM12)) == 0)
+		return 0ull;
+	
+	return ((OCR1A + 1ull) * prescale * 1000000000ull) / F_CPU;
+}
+
+
+/**
+ * The time between Timer2 compare matches according to its registers, or 0 if
+ * it is stopped.
+ */
+static unsigned long long timer2_period_ns(void) {
+	unsigned long long prescale;
+	switch (TCCR2B & (_BV(CS22) | _BV(CS21) | _BV(CS20))) {
+		case 1:  prescale = 1ull;    break;
+		case 2:  prescale = 8ull;    break;
+		case 3:  prescale = 32ull;   break;
+		case 4:  prescale = 64ull;   break;
+		case 5:  prescale = 128ull;  break;
+		case 6:  prescale = 256ull;  break;
+		case 7:  prescale = 1024ull; break;
+		default: return 0ull;
+	}
+	
+	// Only clear-timer-on-compare (with OCR2A as TOP) is supported
+	if ((TCCR2A & _BV(WGM21)) == 0)
+		return 0ull;
+	
+	return ((OCR2A + 1ull) * prescale * 1000000000ull) / F_CPU;
+}
+
+
+/**
+ * Timer2 has reached OCR2A.
+ */
+static void timer2_compare_match(void) {
+	TIFR2.flags |= _BV(OCF2A);
+	if ((TIMSK2 & _BV(OCIE2A)) && (SREG & _BV(SREG_I)) && TIMER2_COMPA_vect) {
+		TIFR2.flags &= ~_BV(OCF2A);
+		TIMER2_COMPA_vect();
+	}
+}
+
+
+/**
+ * Timer1 has reached OCR1A (and thus also OCR1B, which is assumed to be no
+ * greater).
+ */
+static void timer1_compare_match(void) {
+	// Auto-triggered ADC conversions start on the compare match B flag being set
+	// (and so only if the handler cleared it after the last conversion).
+	bool adc_trigger = (TIFR1.flags & _BV(OCF1B)) == 0;
+	TIFR1.flags |= _BV(OCF1A) | _BV(OCF1B);
+	
+	if (adc_trigger
+	    && (ADCSRA & _BV(ADEN)) && (ADCSRA & _BV(ADATE))
+	    && (ADCSRB & (_BV(ADTS2) | _BV(ADTS1) | _BV(ADTS0))) == (_BV(ADTS2) | _BV(ADTS0))) {
+		int value = sim_analog_read(ADMUX & 0x0F);
+		ADC = (value < 0) ? 0 : (value > 1023) ? 1023 : value;
+		ADCSRA |= _BV(ADIF);
+		if ((ADCSRA & _BV(ADIE)) && (SREG & _BV(SREG_I)) && ADC_vect) {
+			ADCSRA &= ~_BV(ADIF);
+			ADC_vect();
+		}
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////////
+
+void sim_begin(time_t t) {
+	time_ns = 0ull;
+	
+	memset(analog_in, 0, sizeof(analog_in));
+	memset(digital_out, 0, sizeof(digital_out));
+	
+	// Inputs float high (e.g. the tilt switches' pull-ups)
+	for (int i = 0; i < NUM_PINS; i++)
+		digital_in[i] = true;
+	
+	max7219_reset();
+	
+	SREG = _BV(SREG_I);
+	spi_interrupt_enabled = false;
+	spi_busy = false;
+	
+	TCCR1A = TCCR1B = TIMSK1 = TIFR1.flags = 0;
+	TCNT1 = OCR1A = OCR1B = 0;
+	timer1_running = false;
+	TCCR2A = TCCR2B = TCNT2 = OCR2A = TIMSK2 = TIFR2.flags = 0;
+	timer2_running = false;
+	ADMUX = ADCSRA = ADCSRB = 0;
+	ADC = 0;
+	
+	sim_rtc_set(t);
+}
+
+
+unsigned long long sim_time_us(void) {
+	return time_ns / 1000ull;
+}
+
+
+void sim_advance_us(unsigned long long us) {
+	sim_advance_ns(us * 1000ull);
+}
+
+
+void sim_advance_ns(unsigned long long ns) {
+	unsigned long long end_ns = time_ns + ns;
+	
+	// Process each hardware event due in this time in order, running interrupt
+	// handlers at the moment the event occurs (these may trigger further
+	// events, e.g. by starting another SPI transfer).
+	while (true) {
+		unsigned long long timer1_period = timer1_period_ns();
+		if (timer1_period && !timer1_running)
+			timer1_match_ns = time_ns + timer1_period;
+		timer1_running = timer1_period != 0ull;
+		
+		unsigned long long timer2_period = timer2_period_ns();
+		if (timer2_period && !timer2_running)
+			timer2_match_ns = time_ns + timer2_period;
+		timer2_running = timer2_period != 0ull;
+		
+		// Find the earliest event due (SPI first on a tie)
+		unsigned long long event_ns = end_ns + 1ull;
+		int event = 0;
+		if (spi_busy && spi_done_ns < event_ns) {
+			event_ns = spi_done_ns;
+			event = 1;
+		}
+		if (timer1_running && timer1_match_ns < event_ns) {
+			event_ns = timer1_match_ns;
+			event = 2;
+		}
+		if (timer2_running && timer2_match_ns < event_ns) {
+			event_ns = timer2_match_ns;
+			event = 3;
+		}
+		
+		if (event == 1) {
+			// SPI transfer complete
+			time_ns = spi_done_ns;
+			spi_busy = false;
+			if (spi_interrupt_enabled && (SREG & _BV(SREG_I)) && SPI_STC_vect)
+				SPI_STC_vect();
+		} else if (event == 2) {
+			time_ns = timer1_match_ns;
+			timer1_match_ns += timer1_period;
+			timer1_compare_match();
+		} else if (event == 3) {
+			time_ns = timer2_match_ns;
+			timer2_match_ns += timer2_period;
+			timer2_compare_match();
+		} else {
+			break;
+		}
+	}
+	
+	time_ns = end_ns;
+}
+
+
+void sim_set_analog(int pin, int value) {
+	if (pin >= 0 && pin < NUM_PINS)
+		analog_in[pin] = value;
+}
+
+
+void sim_set_digital(int pin, bool value) {
+	if (pin >= 0 && pin < NUM_PINS)
+		digital_in[pin] = value;
+}
+
+
+bool sim_get_digital(int pin) {
+	return (pin >= 0 && pin < NUM_PINS) ? digital_out[pin] : false;
+}
+
+
+time_t sim_rtc_get(void) {
+	return rtc_time + (time_t)((sim_time_us() - rtc_set_us) / 1000000ull);
+}
+
+
+void sim_rtc_set(time_t t) {
+	rtc_time = t;
+	rtc_set_us = sim_time_us();
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Hooks used by the Arduino API implementation (arduino.cpp)
+////////////////////////////////////////////////////////////////////////////////
+
+void sim_digital_write(int pin, bool value) {
+	if (pin < 0 || pin >= NUM_PINS)
+		return;
+	
+	digital_out[pin] = value;
+	
+	if (pin == nEN_PIN)
+		max7219_load(value);
+}
+
+
+bool sim_digital_read(int pin) {
+	return (pin >= 0 && pin < NUM_PINS) ? digital_in[pin] : false;
+}
+
+
+int sim_analog_read(int pin) {
+	return (pin >= 0 && pin < NUM_PINS) ? analog_in[pin] : 0;
+}
+
+
+void sim_spi_write(uint8_t data) {
+	spi_done_ns = time_ns + max7219_shift(data);
+	spi_busy = true;
+}
+
+
+void sim_spi_interrupt_enable(bool enabled) {
+	spi_interrupt_enabled = enabled;
+}
+
+
+void sim_yield(void) {
+	// Skip ahead to the next hardware event (if any)
+	if (spi_busy)
+		sim_advance_ns(spi_done_ns - time_ns);
+}
@@ -0,0 +1,59 @@
+/**
+ * Simulated word clock hardware for running the firmware on a Linux host.
+ *
+ * Time is virtual: it only advances when sim_advance_us() is called (e.g. by
+ * the simulator's main loop) so the firmware runs as fast as the host allows
+ * while seeing a consistent clock. Interrupt handlers for hardware events (e.g.
+ * an SPI transfer completing) are called at the appropriate moment as time is
+ * advanced.
+ */
+
+#ifndef SIM_H
+#define SIM_H
+
+#include <time.h>
+
+/**
+ * Reset all simulated hardware to its power-on state with the RTC set to the
+ * given time.
+ */
+void sim_begin(time_t rtc_time);
+
+/**
+ * The number of microseconds of virtual time since sim_begin.
+ */
+unsigned long long sim_time_us(void);
+
+/**
+ * Advance virtual time.
+ */
+void sim_advance_us(unsigned long long us);
+void sim_advance_ns(unsigned long long ns);
+
+/**
+ * Set the value returned by analogRead for the given (analogue) pin, e.g. the
+ * LDR.
+ */
+void sim_set_analog(int pin, int value);
+
+/**
+ * Set the level seen by digitalRead for the given pin, e.g. the tilt switches.
+ */
+void sim_set_digital(int pin, bool value);
+
+/**
+ * Get the level most recently written to a pin with digitalWrite.
+ */
+bool sim_get_digital(int pin);
+
+/**
+ * The current time according to the simulated RTC.
+ */
+time_t sim_rtc_get(void);
+
+/**
+ * Set the simulated RTC.
+ */
+void sim_rtc_set(time_t t);
+
+#endif
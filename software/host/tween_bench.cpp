@@ -0,0 +1,311 @@
+/**
+ * Checks the incremental tween animations (the wipes, dissolve and reveal) by
+ * stepping each to completion against the simulated clock, for random pairs of
+ * frames and for the word masks of successive times of day.
+ *
+ * Every frame of a tween must show each pixel as it is in either the starting
+ * or ending frame, pixels must not revert once changed, the animation must
+ * keep pace with the clock and the final frame must be the ending frame. The
+ * reveal must additionally change exactly the pixels which differ between the
+ * frames, in reading order. The number of pixels changed per frame is
+ * reported for each animation.
+ *
+ * Usage:
+ *
+ *   tween_bench [-n pairs] [-d duration[,duration...]] [-f frame_usec]
+ *
+ *   -n  Pairs of frames tweened between per animation (default: 20).
+ *   -d  Tween duration(s) (ms) to test (default: 500,30000).
+ *   -f  Time (usec) between frames (default: FRAME_PERIOD_USEC).
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <vector>
+
+#include <Arduino.h>
+
+#include "word_clock.h"
+#include "frame.h"
+#include "words.h"
+#include "strbuf.h"
+#include "tween.h"
+#include "sim.h"
+
+
+typedef enum {
+	// Random pairs of frames
+	PAIRS_RANDOM,
+	
+	// The word masks of successive times, five minutes apart
+	PAIRS_WORDS,
+	
+	// The word masks of successive times with the ending frame replaced by the
+	// starting frame half way through the tween
+	PAIRS_WORDS_CHANGED,
+	
+	NUM_PAIRS,
+} pairs_t;
+
+static const char *PAIRS_NAMES[NUM_PAIRS] = {
+	"random",
+	"words",
+	"words chg",
+};
+
+static const tween_animation_t ANIMATIONS[] = {
+	TWEEN_WIPE_LEFT,
+	TWEEN_WIPE_RIGHT,
+	TWEEN_WIPE_UP,
+	TWEEN_WIPE_DOWN,
+	TWEEN_DISSOLVE,
+	TWEEN_REVEAL,
+};
+
+static const char *ANIMATION_NAMES[] = {
+	"wipe left",
+	"wipe right",
+	"wipe up",
+	"wipe down",
+	"dissolve",
+	"reveal",
+};
+
+#define NUM_ANIMATIONS (sizeof(ANIMATIONS) / sizeof(ANIMATIONS[0]))
+
+
+static void random_frame(frame_t *buf) {
+	for (int y = 0; y < HEIGHT; y++)
+		buf->rows[y] = (frame_row_t)rand() & FRAME_ROW_MASK;
+}
+
+
+/**
+ * Set a frame to the word mask of a time of day.
+ */
+static void time_frame(frame_t *buf, int minutes) {
+	char str_buf[100];
+	strbuf_t str;
+	strbuf_init(&str, str_buf, sizeof(str_buf));
+	words_append_time(&str, (minutes / 60) % 24, minutes % 60);
+	if (!words_set_mask(buf, str.str)) {
+		fprintf(stderr, "ERROR: Cannot show the time '%s'\n", str.str);
+		exit(1);
+	}
+}
+
+
+/**
+ * The number of steps of an animation which should have been applied by the
+ * given point in a tween.
+ */
+static unsigned int expected_steps(unsigned long long elapsed,
+                                   unsigned long long duration,
+                                   unsigned int num_steps) {
+	return (elapsed * num_steps) / duration;
+}
+
+
+/**
+ * Results of tweening between a number of pairs of frames.
+ */
+typedef struct {
+	unsigned long tweens;
+	unsigned long frames;
+	unsigned long pixels_changed;
+	unsigned int max_pixels_per_frame;
+	unsigned long errors;
+} result_t;
+
+
+/**
+ * Step a tween to completion, checking every frame it produces.
+ *
+ * @param change_to If non-NULL, the ending frame is set to this half way
+ *                  through the tween.
+ */
+static void run_tween(result_t *result,
+                      tween_animation_t animation,
+                      const frame_t *from,
+                      frame_t *to,
+                      const frame_t *change_to,
+                      unsigned long duration,
+                      unsigned long frame_usec) {
+	tween_t tween;
+	tween_start(&tween, from, to, animation, duration);
+	unsigned long long start = sim_time_us();
+	
+	frame_t blank;
+	frame_clear(&blank);
+	if (!from)
+		from = &blank;
+	
+	// The pixels which should change, in reading order
+	std::vector<int> differing;
+	for (int i = 0; i < WIDTH * HEIGHT; i++)
+		if (frame_get(from, i % WIDTH, i / WIDTH) != frame_get(to, i % WIDTH, i / WIDTH))
+			differing.push_back(i);
+	
+	frame_t shown;
+	frame_copy(&shown, from);
+	bool changed = false;
+	bool finished = false;
+	unsigned long errors = 0;
+	unsigned long long max_frames = ((duration * 1000ull) / frame_usec) + 2;
+	for (unsigned long long n = 0; n <= max_frames && !finished; n++) {
+		sim_advance_us(frame_usec);
+		
+		if (change_to && !changed
+		    && (sim_time_us() - start) * 2 >= duration * 1000ull) {
+			frame_copy(to, change_to);
+			changed = true;
+		}
+		
+		unsigned int steps = tween.steps;
+		int from_level;
+		int to_level;
+		if (!tween_next(&tween, &from_level, &to_level))
+			break;
+		finished = !tween_running(&tween);
+		result->frames++;
+		
+		if (from_level != 0 || to_level != TWEEN_LEVEL_MAX)
+			errors++;
+		
+		// Pixels must be as in either frame and not revert once changed (which
+		// no longer holds once the ending frame has been changed)
+		const frame_t *frame = tween_frame(&tween);
+		unsigned int pixels = 0;
+		for (int y = 0; y < HEIGHT; y++) {
+			for (int x = 0; x < WIDTH; x++) {
+				bool now = frame_get(frame, x, y);
+				bool before = frame_get(&shown, x, y);
+				if (now != before)
+					pixels++;
+				if (!changed
+				    && ((now != frame_get(from, x, y) && now != frame_get(to, x, y))
+				        || (now != before && before != frame_get(from, x, y))))
+					errors++;
+			}
+		}
+		frame_copy(&shown, frame);
+		result->pixels_changed += pixels;
+		if (pixels > result->max_pixels_per_frame)
+			result->max_pixels_per_frame = pixels;
+		
+		if (finished || changed)
+			continue;
+		
+		// The animation must keep pace with the clock (to within a step as
+		// tween_next works in whole ms) without going backwards
+		unsigned int expected = expected_steps(sim_time_us() - start,
+		                                       duration * 1000ull,
+		                                       tween.num_steps);
+		if (tween.steps < steps || tween.steps + 1 < expected || tween.steps > expected)
+			errors++;
+		
+		// The reveal changes the differing pixels in reading order
+		if (animation == TWEEN_REVEAL) {
+			for (size_t i = 0; i < differing.size(); i++) {
+				int x = differing[i] % WIDTH;
+				int y = differing[i] / WIDTH;
+				bool revealed = i < tween.steps;
+				if (frame_get(frame, x, y) != frame_get(revealed ? to : from, x, y))
+					errors++;
+			}
+		}
+	}
+	
+	// The tween must end exactly once, on the ending frame
+	int from_level;
+	int to_level;
+	if (!finished || tween_next(&tween, &from_level, &to_level))
+		errors++;
+	if (memcmp(&shown, to, sizeof(frame_t)) != 0)
+		errors++;
+	
+	if (animation == TWEEN_REVEAL && !change_to
+	    && tween.num_steps != differing.size())
+		errors++;
+	
+	result->tweens++;
+	result->errors += errors;
+}
+
+
+int main(int argc, char *argv[]) {
+	int num_pairs = 20;
+	std::vector<unsigned long> durations;
+	unsigned long frame_usec = FRAME_PERIOD_USEC;
+	
+	int opt;
+	while ((opt = getopt(argc, argv, "n:d:f:")) != -1) {
+		switch (opt) {
+			case 'n': num_pairs = atoi(optarg); break;
+			case 'd':
+				for (char *s = strtok(optarg, ","); s; s = strtok(NULL, ","))
+					durations.push_back(strtoul(s, NULL, 10));
+				break;
+			case 'f': frame_usec = strtoul(optarg, NULL, 10); break;
+			default:
+				fprintf(stderr, "Usage: %s [-n pairs] [-d duration[,duration...]] [-f frame_usec]\n", argv[0]);
+				return 1;
+		}
+	}
+	if (durations.empty()) {
+		durations.push_back(500);
+		durations.push_back(30000);
+	}
+	
+	unsigned long total_errors = 0;
+	
+	printf("%-12s %-10s %8s %8s %10s %10s %10s %8s\n",
+	       "animation", "pairs", "ms", "tweens", "fr/tween", "px/tween", "max px/fr", "errors");
+	for (size_t a = 0; a < NUM_ANIMATIONS; a++) {
+		for (int p = 0; p < NUM_PAIRS; p++) {
+			for (size_t d = 0; d < durations.size(); d++) {
+				sim_begin(0);
+				srand(p);
+				
+				result_t result;
+				memset(&result, 0, sizeof(result));
+				for (int i = 0; i < num_pairs; i++) {
+					frame_t from;
+					frame_t to;
+					frame_t change_to;
+					if (p == PAIRS_RANDOM) {
+						random_frame(&from);
+						random_frame(&to);
+					} else {
+						time_frame(&from, i * 5);
+						time_frame(&to, (i + 1) * 5);
+						frame_copy(&change_to, &from);
+					}
+					
+					// Also start some tweens from black
+					run_tween(&result, ANIMATIONS[a],
+					          (i % 4 == 0) ? NULL : &from, &to,
+					          (p == PAIRS_WORDS_CHANGED) ? &change_to : NULL,
+					          durations[d], frame_usec);
+				}
+				
+				printf("%-12s %-10s %8lu %8lu %10.1f %10.1f %10u %8lu\n",
+				       ANIMATION_NAMES[a], PAIRS_NAMES[p], durations[d],
+				       result.tweens,
+				       (double)result.frames / result.tweens,
+				       (double)result.pixels_changed / result.tweens,
+				       result.max_pixels_per_frame,
+				       result.errors);
+				total_errors += result.errors;
+			}
+		}
+	}
+	
+	if (total_errors)
+		printf("FAILED: %lu errors\n", total_errors);
+	
+	return total_errors ? 1 : 0;
+}
@@ -0,0 +1,179 @@
+/**
+ * Checks the firmware's handling of timezone (UNICOM_FRAME_TZ) frames against
+ * the simulated hardware: valid rules must be adopted and saved to EEPROM and
+ * produce the expected local times while invalid rules must leave both the
+ * rules in use and those saved untouched.
+ *
+ * Usage:
+ *
+ *   tz_bench
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include <Arduino.h>
+
+#include "word_clock.h"
+#include "unicom_frame.h"
+#include "tz.h"
+#include "sim.h"
+
+// Defined by the firmware
+void setup(void);
+void unicom_handle_frame(const unicom_frame_decoder_t *dec, unsigned long frame_started);
+extern tz_t unicom_tz;
+
+
+/**
+ * A timezone frame's payload fields (see UNICOM_FRAME_TZ).
+ */
+typedef struct {
+	const char *name;
+	bool valid;
+	int std_offset;
+	int dst_offset;
+	unsigned char rules[6];
+} tz_case_t;
+
+static const tz_case_t CASES[] = {
+	// Europe/London: DST from 01:00 UTC on the last Sunday of March to 01:00
+	// UTC on the last Sunday of October
+	{"london",      true,    0, 60, {3, 5, 1, 10, 5, 1}},
+	
+	// America/New_York: DST from 07:00 UTC on the second Sunday of March to
+	// 06:00 UTC on the first Sunday of November
+	{"new york",    true, -300, 60, {3, 2, 7, 11, 1, 6}},
+	
+	{"month 0",     false,   0, 60, {0, 5, 1, 10, 5, 1}},
+	{"month 13",    false,   0, 60, {3, 5, 1, 13, 5, 1}},
+	{"sunday 0",    false,   0, 60, {3, 0, 1, 10, 5, 1}},
+	{"sunday 6",    false,   0, 60, {3, 5, 1, 10, 6, 1}},
+	{"hour 24",     false,   0, 60, {3, 5, 24, 10, 5, 1}},
+	{"all 0xFF",    false,  -1, -1, {0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF}},
+};
+
+#define NUM_CASES (sizeof(CASES) / sizeof(CASES[0]))
+
+
+/**
+ * Times either side of DST transitions and the local time expected for each
+ * under the rules of the named valid case.
+ */
+typedef struct {
+	const char *name;
+	time_t utc;
+	time_t local;
+} local_case_t;
+
+static const local_case_t LOCAL_CASES[] = {
+	{"london",   1427590799, 1427590799},        // 2015-03-29 00:59:59 UTC
+	{"london",   1427590800, 1427590800 + 3600}, // 2015-03-29 01:00:00 UTC
+	{"london",   1445734799, 1445734799 + 3600}, // 2015-10-25 00:59:59 UTC
+	{"london",   1445734800, 1445734800},        // 2015-10-25 01:00:00 UTC
+	{"new york", 1425797999, 1425797999 - 18000}, // 2015-03-08 06:59:59 UTC
+	{"new york", 1425798000, 1425798000 - 14400}, // 2015-03-08 07:00:00 UTC
+	{"new york", 1446357599, 1446357599 - 14400}, // 2015-11-01 05:59:59 UTC
+	{"new york", 1446357600, 1446357600 - 18000}, // 2015-11-01 06:00:00 UTC
+};
+
+#define NUM_LOCAL_CASES (sizeof(LOCAL_CASES) / sizeof(LOCAL_CASES[0]))
+
+
+/**
+ * Deliver a timezone frame to the firmware as the unicom receiver would.
+ */
+static void send_tz(const tz_case_t *c) {
+	unsigned char payload[10];
+	payload[0] = c->std_offset & 0xFF;
+	payload[1] = (c->std_offset >> 8) & 0xFF;
+	payload[2] = c->dst_offset & 0xFF;
+	payload[3] = (c->dst_offset >> 8) & 0xFF;
+	memcpy(payload + 4, c->rules, sizeof(c->rules));
+	
+	unsigned char frame[sizeof(payload) + UNICOM_FRAME_OVERHEAD];
+	size_t length = unicom_frame_encode(frame, UNICOM_FRAME_TZ, payload, sizeof(payload));
+	
+	unicom_frame_decoder_t dec;
+	unicom_frame_init(&dec);
+	for (size_t i = 0; i < length; i++) {
+		if (unicom_frame_push(&dec, frame[i]) == UNICOM_FRAME_OK) {
+			unicom_handle_frame(&dec, millis());
+			return;
+		}
+	}
+	
+	fprintf(stderr, "ERROR: Test frame '%s' was not decoded\n", c->name);
+}
+
+
+/**
+ * Do the rules match those sent in a case?
+ */
+static bool tz_matches(const tz_t *tz, const tz_case_t *c) {
+	return tz->std_offset == c->std_offset
+	    && tz->dst_offset == c->dst_offset
+	    && tz->dst_start.month  == c->rules[0]
+	    && tz->dst_start.sunday == c->rules[1]
+	    && tz->dst_start.hour   == c->rules[2]
+	    && tz->dst_end.month    == c->rules[3]
+	    && tz->dst_end.sunday   == c->rules[4]
+	    && tz->dst_end.hour     == c->rules[5];
+}
+
+
+int main(int argc, char *argv[]) {
+	sim_begin(1420372800); // 2015-01-04 12:00:00
+	setup();
+	
+	int total_errors = 0;
+	
+	// Each case is sent with the rules of the previous valid case in force
+	printf("%-10s %8s %8s %8s %8s\n", "case", "valid", "in use", "saved", "errors");
+	const tz_case_t *current = NULL;
+	for (size_t i = 0; i < NUM_CASES; i++) {
+		const tz_case_t *c = &CASES[i];
+		send_tz(c);
+		if (c->valid)
+			current = c;
+		
+		tz_t saved;
+		bool loaded = tz_load(&saved, TZ_EEPROM_ADDR);
+		
+		bool in_use_ok = current ? tz_matches(&unicom_tz, current) : !tz_matches(&unicom_tz, c);
+		bool saved_ok = current ? (loaded && tz_matches(&saved, current)) : !loaded;
+		int errors = (tz_valid(&unicom_tz) ? 0 : 1)
+		           + (in_use_ok ? 0 : 1)
+		           + (saved_ok ? 0 : 1);
+		
+		printf("%-10s %8s %8s %8s %8d\n",
+		       c->name, c->valid ? "yes" : "no",
+		       in_use_ok ? "ok" : "WRONG", saved_ok ? "ok" : "WRONG",
+		       errors);
+		total_errors += errors;
+	}
+	
+	// The local time produced by the valid rules
+	printf("\n%-10s %12s %12s %12s\n", "rules", "utc", "local", "expected");
+	for (size_t i = 0; i < NUM_LOCAL_CASES; i++) {
+		const local_case_t *l = &LOCAL_CASES[i];
+		for (size_t j = 0; j < NUM_CASES; j++) {
+			if (strcmp(CASES[j].name, l->name) == 0) {
+				send_tz(&CASES[j]);
+				break;
+			}
+		}
+		
+		time_t local = tz_local_time(&unicom_tz, l->utc);
+		printf("%-10s %12ld %12ld %12ld%s\n",
+		       l->name, (long)l->utc, (long)local, (long)l->local,
+		       (local == l->local) ? "" : " WRONG");
+		if (local != l->local)
+			total_errors++;
+	}
+	
+	if (total_errors)
+		printf("FAILED: %d errors\n", total_errors);
+	
+	return total_errors ? 1 : 0;
+}
@@ -0,0 +1,307 @@
+/**
+ * Measures the unicom receiver's performance by feeding synthetic LDR
+ * waveforms through the real UnicomReceiver (and its background sampler)
+ * against the simulated hardware, reporting lock time, throughput, bit error
+ * rate and the number of LDR samples lost because the main loop polled the
+ * receiver too slowly to drain the sampler's ring.
+ *
+ * The waveform is what the receiver expects from a flashing screen: a run of
+ * sync pulses (Manchester encoded ones), a start bit (a zero) and then the
+ * payload bytes, most significant bit first. Various impairments can be
+ * added, and the LDR's sample period varied, to find the limits of the
+ * receiver and to tune its constants (THRESH_SPEED, LOG_MAX_JITTER,
+ * SYNC_DURATION, etc., which requires rebuilding) from data.
+ *
+ * Usage:
+ *
+ *   unicom_bench [-p period[,period...]] [-n bytes] [-r runs] [-y sync_bits]
+ *                [-S sample_usec] [-V sample_var] [-k skew] [-j jitter]
+ *                [-N noise] [-c contrast] [-A ambient_drift] [-T ldr_tau]
+ *                [-P poll_usec] [-s seed] [-v]
+ *
+ *   -p  Bit period(s) (usec) to test (default: 20000,10000,7000).
+ *   -n  Random payload bytes sent per run (default: 32).
+ *   -r  Runs per bit period (default: 20).
+ *   -y  Sync pulses sent before the start bit (default: 16).
+ *   -S  LDR sample period (usec, default: UNICOM_SAMPLE_PERIOD_USEC).
+ *   -V  Vary the sample period of each run by up to this fraction either way
+ *       (default: 0).
+ *   -k  Sender clock skew: fractional change in the bit period over the
+ *       course of a run (default: 0), e.g. 0.05 ends 5% slower.
+ *   -j  Edge timing jitter, as a fraction of the period (default: 0.02).
+ *   -N  Standard deviation of the LDR noise (ADC counts, default: 10).
+ *   -c  Difference between a lit and dark screen (ADC counts, default: 400).
+ *   -A  Amplitude of slow ambient light drift (ADC counts, default: 50).
+ *   -T  LDR response time constant, as a fraction of the period
+ *       (default: 0.1).
+ *   -P  Interval (usec, a multiple of 10) at which the main loop polls the
+ *       receiver (default: 1000).
+ *   -s  Random seed (default: 1).
+ *   -v  Print the result of every run.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <math.h>
+
+#include <vector>
+
+#include <Arduino.h>
+
+#include "word_clock.h"
+#include "UnicomReceiver.h"
+#include "ldr_sampler.h"
+#include "sim.h"
+
+// Resolution (usec) with which the waveform is generated
+#define STEP_US 10ull
+
+// Idle time (usec) before the signal starts and after it ends
+#define LEAD_IN_US 500000ull
+#define LEAD_OUT_US 500000ull
+
+// Period (usec) of the ambient light drift
+#define AMBIENT_PERIOD_US 3000000.0
+
+// Dark-screen ADC level
+#define DARK_LEVEL 200.0
+
+
+typedef struct {
+	double skew;
+	double jitter;
+	double noise;
+	double contrast;
+	double ambient;
+	double tau;
+	int sync_bits;
+	int num_bytes;
+	unsigned long sample_us;
+	double sample_var;
+	
+	// Interval (usec) at which the receiver is polled (i.e. the main loop)
+	unsigned long long poll_us;
+} impairments_t;
+
+typedef struct {
+	// Did the receiver lock and start receiving?
+	bool locked;
+	
+	// Time (usec) from the start of the signal until locking
+	double lock_us;
+	
+	// Payload bits sent and bits wrong or missing
+	long bits;
+	long bit_errors;
+	
+	// Time (usec) from the start bit to the end of the payload
+	double transfer_us;
+	
+	// LDR samples lost because the sampler's ring was full
+	unsigned long dropped;
+} run_result_t;
+
+
+static double uniform(void) {
+	return (rand() + 0.5) / (RAND_MAX + 1.0);
+}
+
+static double gaussian(void) {
+	return sqrt(-2.0 * log(uniform())) * cos(2.0 * M_PI * uniform());
+}
+
+
+/**
+ * Send one random payload through the receiver.
+ */
+static run_result_t run(double period, const impairments_t *imp) {
+	run_result_t result;
+	memset(&result, 0, sizeof(result));
+	
+	// The bits to send
+	std::vector<unsigned char> payload(imp->num_bytes);
+	for (int i = 0; i < imp->num_bytes; i++)
+		payload[i] = rand() & 0xFF;
+	std::vector<bool> bits;
+	for (int i = 0; i < imp->sync_bits; i++)
+		bits.push_back(1);
+	bits.push_back(0);
+	for (int i = 0; i < imp->num_bytes; i++)
+		for (int b = 7; b >= 0; b--)
+			bits.push_back((payload[i] >> b) & 1);
+	
+	// Bit boundaries, with the period drifting by the skew over the run, and
+	// the (jittered) mid-bit edge time of each bit.
+	size_t num_bits = bits.size();
+	std::vector<double> start(num_bits + 1);
+	std::vector<double> middle(num_bits);
+	double t = LEAD_IN_US;
+	for (size_t i = 0; i <= num_bits; i++) {
+		start[i] = t;
+		t += period * (1.0 + (imp->skew * i) / num_bits);
+	}
+	for (size_t i = 0; i < num_bits; i++)
+		middle[i] = (start[i] + start[i + 1]) / 2.0
+		          + (uniform() * 2.0 - 1.0) * imp->jitter * period;
+	double start_bit_us = start[imp->sync_bits];
+	double end_us = start[num_bits];
+	
+	sim_begin(0);
+	UnicomReceiver receiver(LDR_PIN);
+	receiver.begin((unsigned long)(imp->sample_us
+	                               * (1.0 + (uniform() * 2.0 - 1.0) * imp->sample_var)));
+	
+	double ambient_phase = uniform() * 2.0 * M_PI;
+	double lit = 0.0;
+	size_t bit = 0;
+	std::vector<unsigned char> received;
+	for (unsigned long long now = 0ull; now < end_us + LEAD_OUT_US; now += STEP_US) {
+		// The screen (Manchester: each bit's value is shown in its second half)
+		bool screen = false;
+		while (bit < num_bits && now >= start[bit + 1])
+			bit++;
+		if (now >= start[0] && bit < num_bits)
+			screen = (now >= middle[bit]) ? bits[bit] : !bits[bit];
+		
+		// As seen through the LDR
+		double tau = imp->tau * period;
+		lit += ((screen ? 1.0 : 0.0) - lit) * (1.0 - exp(-(double)STEP_US / tau));
+		double level = DARK_LEVEL
+		             + lit * imp->contrast
+		             + imp->ambient * sin(ambient_phase + (2.0 * M_PI * now) / AMBIENT_PERIOD_US)
+		             + imp->noise * gaussian();
+		sim_set_analog(LDR_PIN, (int)level);
+		
+		if (now % imp->poll_us == 0ull) {
+			receiver.refresh();
+			
+			if (!result.locked && receiver.getState() != UnicomReceiver::STATE_SYNCING) {
+				result.locked = true;
+				result.lock_us = now - start[0];
+			}
+			
+			char c;
+			while (receiver.getByte(&c))
+				received.push_back(c);
+		}
+		
+		sim_advance_us(STEP_US);
+	}
+	
+	// Compare what arrived (bytes not received count as entirely wrong)
+	result.bits = imp->num_bytes * 8l;
+	for (int i = 0; i < imp->num_bytes; i++) {
+		if (i < (int)received.size())
+			result.bit_errors += __builtin_popcount(payload[i] ^ received[i]);
+		else
+			result.bit_errors += 8;
+	}
+	result.transfer_us = end_us - start_bit_us;
+	result.dropped = ldr_sampler_dropped();
+	
+	return result;
+}
+
+
+int main(int argc, char *argv[]) {
+	std::vector<double> periods;
+	int runs = 20;
+	unsigned int seed = 1;
+	bool verbose = false;
+	
+	impairments_t imp;
+	imp.skew = 0.0;
+	imp.jitter = 0.02;
+	imp.noise = 10.0;
+	imp.contrast = 400.0;
+	imp.ambient = 50.0;
+	imp.tau = 0.1;
+	imp.sync_bits = 16;
+	imp.num_bytes = 32;
+	imp.sample_us = UNICOM_SAMPLE_PERIOD_USEC;
+	imp.sample_var = 0.0;
+	imp.poll_us = 1000ull;
+	
+	int opt;
+	while ((opt = getopt(argc, argv, "p:n:r:y:S:V:k:j:N:c:A:T:P:s:v")) != -1) {
+		switch (opt) {
+			case 'p':
+				for (char *p = strtok(optarg, ","); p; p = strtok(NULL, ","))
+					periods.push_back(atof(p));
+				break;
+			case 'n': imp.num_bytes = atoi(optarg); break;
+			case 'r': runs = atoi(optarg); break;
+			case 'y': imp.sync_bits = atoi(optarg); break;
+			case 'S': imp.sample_us = strtoul(optarg, NULL, 10); break;
+			case 'V': imp.sample_var = atof(optarg); break;
+			case 'k': imp.skew = atof(optarg); break;
+			case 'j': imp.jitter = atof(optarg); break;
+			case 'N': imp.noise = atof(optarg); break;
+			case 'c': imp.contrast = atof(optarg); break;
+			case 'A': imp.ambient = atof(optarg); break;
+			case 'T': imp.tau = atof(optarg); break;
+			case 'P': imp.poll_us = strtoull(optarg, NULL, 10); break;
+			case 's': seed = strtoul(optarg, NULL, 10); break;
+			case 'v': verbose = true; break;
+			default:
+				fprintf(stderr, "Usage: %s [-p period[,period...]] [-n bytes] [-r runs] "
+				                "[-y sync_bits] [-S sample_usec] [-V sample_var] [-k skew] [-j jitter] "
+				                "[-N noise] [-c contrast] [-A ambient_drift] [-T ldr_tau] "
+				                "[-P poll_usec] [-s seed] [-v]\n", argv[0]);
+				return 1;
+		}
+	}
+	if (periods.empty()) {
+		periods.push_back(20000.0);
+		periods.push_back(10000.0);
+		periods.push_back(7000.0);
+	}
+	
+	srand(seed);
+	
+	printf("%-10s %8s %12s %12s %12s %12s %12s\n",
+	       "period us", "locked", "lock ms", "bit/s", "BER", "clean runs", "dropped");
+	for (size_t p = 0; p < periods.size(); p++) {
+		int locked = 0;
+		int clean = 0;
+		double lock_us = 0.0;
+		double bits_ok = 0.0;
+		double transfer_us = 0.0;
+		long bits = 0;
+		long bit_errors = 0;
+		unsigned long dropped = 0;
+		
+		for (int r = 0; r < runs; r++) {
+			run_result_t result = run(periods[p], &imp);
+			if (verbose)
+				printf("  run %d: %s, lock %.1f ms, %ld/%ld bits wrong, %lu samples dropped\n",
+				       r, result.locked ? "locked" : "no lock", result.lock_us / 1e3,
+				       result.bit_errors, result.bits, result.dropped);
+			
+			if (result.locked) {
+				locked++;
+				lock_us += result.lock_us;
+			}
+			if (result.bit_errors == 0)
+				clean++;
+			bits += result.bits;
+			bit_errors += result.bit_errors;
+			bits_ok += result.bits - result.bit_errors;
+			transfer_us += result.transfer_us;
+			dropped += result.dropped;
+		}
+		
+		printf("%-10.0f %5d/%-2d %12.1f %12.1f %12.2e %9d/%-2d %12lu\n",
+		       periods[p],
+		       locked, runs,
+		       locked ? (lock_us / locked) / 1e3 : 0.0,
+		       bits_ok / (transfer_us / 1e6),
+		       (double)bit_errors / bits,
+		       clean, runs,
+		       dropped);
+	}
+	
+	return 0;
+}
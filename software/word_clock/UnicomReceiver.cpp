@@ -2,13 +2,15 @@
 #include "UnicomReceiver.h"
 
 UnicomReceiver::UnicomReceiver(int analogPin) :
-	analogPin(analogPin),
-	
 	// When we start we need to sync
 	state(STATE_SYNCING),
 	
+	analogPin(analogPin),
+	
 	// Arbitary defaults
 	lastSample(0),
+	lastBrightness(0),
+	lastSampleTime(0),
 	ignoreUntilTime(0),
 	lastEdgeTime(0),
 	syncPulseBufHead(0)
@@ -24,18 +26,48 @@ UnicomReceiver::~UnicomReceiver()
 
 
 /**
- * Insert this into your main loop.
+ * Start sampling the LDR in the background.
+ *
+ * @param samplePeriod Time (usec) between samples.
+ */
+void
+UnicomReceiver::begin(unsigned long samplePeriod)
+{
+	ldr_sampler_begin(analogPin, samplePeriod);
+} // UnicomReceiver::begin
+
+
+/**
+ * Insert this into your main loop. Processes the samples taken since the last
+ * call.
  */
 void
 UnicomReceiver::refresh()
 {
-	// Get current time
-	int brightness = analogRead(analogPin);
-	unsigned long time = millis();
+	ldr_sample_t samples[SAMPLE_BATCH];
+	int numSamples;
+	while ((numSamples = ldr_sampler_read(samples, SAMPLE_BATCH)) > 0)
+		for (int i = 0; i < numSamples; i++)
+			processSample(samples[i].value, samples[i].time);
+} // UnicomReceiver::refresh
+
+
+/**
+ * Run the receiver state machine on a single sample.
+ *
+ * @param brightness The LDR reading.
+ * @param time The time (usec) at which the reading was taken.
+ */
+void
+UnicomReceiver::processSample(int brightness, unsigned long time)
+{
 	bool currentSample = brightness > brightnessThreshold;
 	bool edge          = currentSample != lastSample;
 	bool edgeDirection = currentSample;
+	unsigned long edgeTime = edge ? interpolateEdge(brightness, time) : time;
 	lastSample = currentSample;
+	lastBrightness = brightness;
+	lastSampleTime = time;
 	
 	// Adaptive threshold setting
 	if (state != STATE_RECEIVING) {
@@ -45,35 +77,33 @@ UnicomReceiver::refresh()
 		brightnessThreshold = (minBrightness + maxBrightness) >> (THRESH_SPEED+1);
 	}
 	
-	if (ignoreUntilTime < time) {
+	// Times are compared by their (signed) difference so that micros() wrapping
+	// is harmless.
+	if ((long)(time - ignoreUntilTime) > 0) {
 		// If we've hit an edge, when syncing it must be a positive edge but
 		// otherwise it can be any edge.
 		if (edge && (state != STATE_SYNCING || edgeDirection == 1)) {
-			unsigned long period = time - lastEdgeTime;
-			lastEdgeTime = time;
-			
-			if (isPeriodStable(period)) {
-				// If the period goes stable, lock on
-				if (state == STATE_SYNCING)
+			if (state == STATE_SYNCING) {
+				// Lock on once the sync pulses' period goes stable
+				unsigned long edgePeriod = edgeTime - lastEdgeTime;
+				lastEdgeTime = edgeTime;
+				if (isPeriodStable(edgePeriod))
 					state = STATE_LOCKED;
-			} else {
-				// If the period is unstable and we were previously locked, reset the
-				// period tracker to ensure we don't quickly reconnect without a propper
-				// sync signal.
-				if (state != STATE_SYNCING)
-					periodTrackerReset();
-				
+			} else if (!trackEdge(edgeTime)) {
+				// If the clock drifts out of range, reset the period tracker to
+				// ensure we don't quickly reconnect without a propper sync signal.
+				periodTrackerReset();
 				state = STATE_SYNCING;
 			}
 			
 			if (state == STATE_SYNCING) {
-				ignoreUntilTime = time + (MIN_PERIOD >> 1);
+				ignoreUntilTime = edgeTime + (MIN_PERIOD >> 1);
 			} else {
-				ignoreUntilTime = time + ignoreWindow;
+				ignoreUntilTime = lastEdgeTime + ignoreWindow;
 				onBitReceived(edgeDirection);
 			}
 		} else if (state != STATE_SYNCING
-		           && (ignoreUntilTime + acceptanceWindow) < time) {
+		           && (long)(time - (ignoreUntilTime + acceptanceWindow)) > 0) {
 			// If we're not syncing and we don't see an edge before the end of the
 			// acceptance window, we've lost the connection and must re-sync.
 			periodTrackerReset();
@@ -81,7 +111,32 @@ UnicomReceiver::refresh()
 		}
 	}
 	
-} // UnicomReceiver::refresh
+} // UnicomReceiver::processSample
+
+
+/**
+ * Estimate when the signal crossed the threshold between the last sample and
+ * this one by linear interpolation, giving edge times finer than the sample
+ * period.
+ *
+ * @return The estimated time of the edge.
+ */
+unsigned long
+UnicomReceiver::interpolateEdge(int brightness, unsigned long time)
+{
+	long dt = time - lastSampleTime;
+	long crossing = brightnessThreshold - lastBrightness;
+	long change = brightness - lastBrightness;
+	
+	// Guard against the threshold moving between the samples (or the first
+	// sample) in which case the sample time is the best estimate.
+	if (change == 0 || dt <= 0
+	    || (change > 0 && (crossing < 0 || crossing > change))
+	    || (change < 0 && (crossing > 0 || crossing < change)))
+		return time;
+	
+	return lastSampleTime + (unsigned long)((dt * crossing) / change);
+} // UnicomReceiver::interpolateEdge
 
 
 void
@@ -161,7 +216,7 @@ UnicomReceiver::isPeriodStable(unsigned long currentPeriod)
 	unsigned long max = syncPulseBuf[0];
 	period = 0ul;
 	
-	for (int i = 0; i < SYNC_DURATION; i++) {
+	for (unsigned int i = 0; i < SYNC_DURATION; i++) {
 		min = MIN(min, syncPulseBuf[i]);
 		max = MAX(max, syncPulseBuf[i]);
 		period += syncPulseBuf[i];
@@ -169,25 +224,57 @@ UnicomReceiver::isPeriodStable(unsigned long currentPeriod)
 	
 	// Period = Average(sum of periods)
 	period = period >> LOG_SYNC_DURATION;
-	
-	// Calculate the acceptanceWindow = period / 2
-	acceptanceWindow = period >> 1;
+	updateWindows();
 	
 	// Calculate the maximum allowed jitter
-	unsigned long maxJitter = MIN(acceptanceWindow, MAX_JITTER);
+	unsigned long maxJitter = period >> LOG_MAX_JITTER;
 	
 	// Range of values currently in the buffer is the "jitter" estimate
 	unsigned long jitter = max - min;
 	
-	// Calculate ignore window = 3/4 * period
-	ignoreWindow = acceptanceWindow + (acceptanceWindow>>1);
-	
 	return (jitter < maxJitter)
 	       && (period > MIN_PERIOD)
 	       && (period < MAX_PERIOD);
 } // UnicomReceiver::isPeriodStable
 
 
+/**
+ * Once locked, update the phase-locked loop with an edge seen in the
+ * acceptance window. The timing error against the expected edge time (one
+ * period after the last) nudges both the phase and the period so that the
+ * receiver follows a sender whose clock drifts.
+ *
+ * @return Whether the tracked period remains in the allowed range.
+ */
+bool
+UnicomReceiver::trackEdge(unsigned long edgeTime)
+{
+	unsigned long expected = lastEdgeTime + period;
+	long error = (long)(edgeTime - expected);
+	
+	// (Divisions rather than shifts keep rounding symmetric for negative errors)
+	lastEdgeTime = expected + (error / (1l << LOG_PLL_PHASE_GAIN));
+	period += error / (1l << LOG_PLL_PERIOD_GAIN);
+	updateWindows();
+	
+	return (period > MIN_PERIOD) && (period < MAX_PERIOD);
+} // UnicomReceiver::trackEdge
+
+
+/**
+ * Recalculate the timing windows from the current period.
+ */
+void
+UnicomReceiver::updateWindows()
+{
+	// Calculate the acceptanceWindow = period / 2
+	acceptanceWindow = period >> 1;
+	
+	// Calculate ignore window = 3/4 * period
+	ignoreWindow = acceptanceWindow + (acceptanceWindow>>1);
+} // UnicomReceiver::updateWindows
+
+
 void
 UnicomReceiver::periodTrackerPush(unsigned long period)
 {
@@ -203,6 +290,6 @@ UnicomReceiver::periodTrackerPush(unsigned long period)
 void
 UnicomReceiver::periodTrackerReset()
 {
-	for (int i = 0; i < SYNC_DURATION; i++)
+	for (unsigned int i = 0; i < SYNC_DURATION; i++)
 		syncPulseBuf[i] = 0ul;
 } // UnicomReceiver::periodTrackerReset
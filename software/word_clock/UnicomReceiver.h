@@ -2,6 +2,7 @@
 #define UNICOM_RECEIVER_H
 
 #include "Arduino.h"
+#include "ldr_sampler.h"
 
 #define THRESH_SPEED 4
 
@@ -20,10 +21,22 @@ class UnicomReceiver {
 	
 	private:
 		
-		// Minimum period allowed (msec)
-		static const unsigned int MIN_PERIOD = 50;
-		static const unsigned int MAX_PERIOD = 2000;
-		static const unsigned int MAX_JITTER = 50;
+		// Minimum period allowed (usec)
+		static const unsigned long MIN_PERIOD = 5000ul;
+		static const unsigned long MAX_PERIOD = 2000000ul;
+		
+		// Jitter allowed in the sync pulses when locking (as a fraction of the
+		// period, 1/4)
+		static const unsigned int LOG_MAX_JITTER = 2;
+		
+		// Gains of the phase-locked loop which tracks the clock once locked: the
+		// fraction of each edge's timing error applied to the phase (1/2) and to
+		// the period (1/8).
+		static const unsigned int LOG_PLL_PHASE_GAIN = 1;
+		static const unsigned int LOG_PLL_PERIOD_GAIN = 3;
+		
+		// Number of samples taken from the sampler at once
+		static const int SAMPLE_BATCH = 8;
 		
 		// Number of consecutive sync pulses to require before locking
 		static const unsigned int SYNC_DURATION = 8;
@@ -40,20 +53,23 @@ class UnicomReceiver {
 		int minBrightness;
 		int maxBrightness;
 		
-		// Last value seen
+		// Last value seen (thresholded and raw) and when it was sampled
 		bool lastSample;
+		int lastBrightness;
+		unsigned long lastSampleTime;
 		
 		// Time until which no samples are taken
 		unsigned long ignoreUntilTime;
 		
-		// Time last edge seen
+		// Time last edge seen (or, once locked, the time the PLL places it at)
 		unsigned long lastEdgeTime;
 		
 		// A buffer of sync pulse durations
 		unsigned int  syncPulseBufHead;
 		unsigned long syncPulseBuf[SYNC_DURATION];
 		
-		// Current clock period
+		// Current clock period (estimated from the sync pulses then tracked by the
+		// PLL)
 		unsigned long period;
 		
 		// Byte receiver
@@ -69,13 +85,14 @@ class UnicomReceiver {
 		unsigned long acceptanceWindow;
 		
 		// Time during which the signal is ignored
-		//   ignoreWindow = period / 4
+		//   ignoreWindow = 3 * period / 4
 		unsigned long ignoreWindow;
 		
 	public:
 		UnicomReceiver(int analogPin);
 		~UnicomReceiver();
 		
+		void begin(unsigned long samplePeriod);
 		void refresh();
 		bool getByte(char *byte);
 		int getBitsReceived();
@@ -84,7 +101,12 @@ class UnicomReceiver {
 		state_t getState();
 	
 	private:
+		void processSample(int brightness, unsigned long time);
+		unsigned long interpolateEdge(int brightness, unsigned long time);
+		
 		bool isPeriodStable(unsigned long period);
+		bool trackEdge(unsigned long edgeTime);
+		void updateWindows();
 		
 		void periodTrackerPush(unsigned long period);
 		void periodTrackerReset();
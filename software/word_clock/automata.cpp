@@ -1,45 +1,62 @@
 #include "word_clock.h"
 #include "automata.h"
+#include "frame.h"
 
 
-// Is the given coordinate within the buffer's extents?
-#define EXISTS(x,y) ((x) >= 0 && (x) < WIDTH && (y) >= 0 && (y) < HEIGHT)
+// The row above/below y or zero if the row is not in range of the buffer.
+#define ROW_OR_ZERO(buf, y) (((y) >= 0 && (y) < HEIGHT) ? (buf)->rows[(y)] : 0)
 
-// Return the value of the given coordinate or zero if the coordinate is not in
-// range of the buffer.
-#define ZERO_IF_NOT_EXIST(buf, x, y) ((EXISTS((x),(y))) ? (buf)[(y)*WIDTH + (x)] : 0)
+// Shift a row such that each bit holds the value of the pixel to its
+// right/left (pixels shifted in from beyond the edge of the buffer are zero).
+#define EAST(row) ((frame_row_t)(((row) << 1) & FRAME_ROW_MASK))
+#define WEST(row) ((frame_row_t)((row) >> 1))
 
-void automata_xor(char *to_buf, const char *from_buf) {
-	for (int x = 0; x < WIDTH; x++) {
-		for (int y = 0; y < HEIGHT; y++) {
-			to_buf[y*WIDTH + x] = from_buf[y*WIDTH + x]
-			                    ^ ZERO_IF_NOT_EXIST(from_buf, x+1,y+0)
-			                    ^ ZERO_IF_NOT_EXIST(from_buf, x-1,y+0)
-			                    ^ ZERO_IF_NOT_EXIST(from_buf, x+0,y+1)
-			                    ^ ZERO_IF_NOT_EXIST(from_buf, x+0,y-1)
-			                    ;
-		}
+
+/**
+ * Add a neighbour mask to a bit-sliced counter where counter[i] holds bit i of
+ * the count for every cell in a row. The mask is added with weight 2^bit.
+ */
+static inline void counter_add(frame_row_t counter[4], frame_row_t mask, int bit) {
+	for (; bit < 4 && mask; bit++) {
+		frame_row_t carry = counter[bit] & mask;
+		counter[bit] ^= mask;
+		mask = carry;
+	}
+}
+
+
+void automata_xor(frame_t *to_buf, const frame_t *from_buf) {
+	for (int y = 0; y < HEIGHT; y++) {
+		frame_row_t row = from_buf->rows[y];
+		to_buf->rows[y] = row
+		                ^ EAST(row)
+		                ^ WEST(row)
+		                ^ ROW_OR_ZERO(from_buf, y+1)
+		                ^ ROW_OR_ZERO(from_buf, y-1)
+		                ;
 	}
 }
 
-void automata_life(char *to_buf, const char *from_buf) {
-	for (int x = 0; x < WIDTH; x++) {
-		for (int y = 0; y < HEIGHT; y++) {
-			int live_neighbours = ZERO_IF_NOT_EXIST(from_buf, x+1,y+0)
-			                    + ZERO_IF_NOT_EXIST(from_buf, x-1,y+0)
-			                    + ZERO_IF_NOT_EXIST(from_buf, x+0,y+1)
-			                    + ZERO_IF_NOT_EXIST(from_buf, x+0,y-1)
-			                    + ZERO_IF_NOT_EXIST(from_buf, x+1,y+1)
-			                    + ZERO_IF_NOT_EXIST(from_buf, x-1,y+1)
-			                    + ZERO_IF_NOT_EXIST(from_buf, x+1,y+1)
-			                    + ZERO_IF_NOT_EXIST(from_buf, x+1,y-1)
-			                    ;
-			
-			if (from_buf[y*WIDTH + x]) {
-				to_buf[y*WIDTH + x] = live_neighbours >= 2 && live_neighbours <= 3;
-			} else {
-				to_buf[y*WIDTH + x] = live_neighbours == 3;
-			}
-		}
+void automata_life(frame_t *to_buf, const frame_t *from_buf) {
+	for (int y = 0; y < HEIGHT; y++) {
+		frame_row_t above = ROW_OR_ZERO(from_buf, y-1);
+		frame_row_t row   = from_buf->rows[y];
+		frame_row_t below = ROW_OR_ZERO(from_buf, y+1);
+		
+		// Count the live neighbours of every cell in the row. Note that, for
+		// consistency with the original per-cell implementation, the south-east
+		// neighbour is counted twice and the north-west neighbour is not counted.
+		frame_row_t count[4] = {0, 0, 0, 0};
+		counter_add(count, EAST(row),   0);
+		counter_add(count, WEST(row),   0);
+		counter_add(count, below,       0);
+		counter_add(count, above,       0);
+		counter_add(count, EAST(below), 1);
+		counter_add(count, WEST(below), 0);
+		counter_add(count, EAST(above), 0);
+		
+		// Live cells survive with 2 or 3 neighbours, dead cells come to life with
+		// exactly 3.
+		to_buf->rows[y] = ~count[3] & ~count[2] & count[1] & (count[0] | row);
 	}
 }
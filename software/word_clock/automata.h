@@ -5,14 +5,16 @@
 #ifndef AUTOMATA_H
 #define AUTOMATA_H
 
+#include "frame.h"
+
 /**
  * Simple XOR cellular automata rule as found on our wedding invitations.
  */
-void automata_xor(char *to_buf, const char *from_buf);
+void automata_xor(frame_t *to_buf, const frame_t *from_buf);
 
 /**
  * The game of life.
  */
-void automata_life(char *to_buf, const char *from_buf);
+void automata_life(frame_t *to_buf, const frame_t *from_buf);
 
 #endif
@@ -1,5 +1,7 @@
 #include <Arduino.h>
 #include <SPI.h>
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>
 
 #include "word_clock.h"
 #include "display.h"
@@ -28,16 +30,165 @@
 #define TEST    0x01
 
 
+////////////////////////////////////////////////////////////////////////////////
+// Internal state
+////////////////////////////////////////////////////////////////////////////////
+
+#define NUM_DISPLAYS ((DISPLAYS_X) * (DISPLAYS_Y))
+
+// Shadow copy of the row registers of each display (in scan-path order) as
+// last sent. Used to avoid re-sending rows which have not changed.
+static unsigned char shadow_rows[DISPLAY_HEIGHT][NUM_DISPLAYS];
+
+// The intensity register of each display (in scan-path order) as last sent
+static unsigned char shadow_intensity[NUM_DISPLAYS];
+
+// The intensity of each display (in scan-path order) relative to the global
+// intensity (see display_set_display_intensity())
+static unsigned char display_intensity[NUM_DISPLAYS];
+
+// Every transfer writes one register in every display before being latched
+#define TRANSFER_BYTES ((NUM_DISPLAYS) * 2)
+
+// At most a frame consists of an intensity change and every row changing
+#define MAX_TRANSFERS ((DISPLAY_HEIGHT) + 1)
+
+// Queue of bytes to send for the current frame, sent by the SPI transfer
+// complete interrupt.
+static unsigned char tx_buf[MAX_TRANSFERS * TRANSFER_BYTES];
+static unsigned char tx_len;
+
+// Index in tx_buf of the byte currently being sent
+static volatile unsigned char tx_pos;
+
+// Is a frame being sent?
+static volatile bool tx_busy;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Scan path mapping (evaluated at compile time)
+////////////////////////////////////////////////////////////////////////////////
+
+// The displays are numbered here in the order their data is sent which is the
+// reverse of the scan path: the first data sent is shifted furthest along it.
+
+// Where the pixels for one row register of one display come from in a frame
+typedef struct {
+	// The frame row
+	unsigned char row;
+	
+	// Right shift bringing the display's columns to the bottom of the row
+	unsigned char shift;
+	
+	// Are the columns shown in reverse order? (Non-zero if so)
+	unsigned char mirror;
+} scan_slot_t;
+
+typedef struct {
+	scan_slot_t slots[DISPLAY_HEIGHT][NUM_DISPLAYS];
+} scan_path_t;
+
+typedef struct {
+	unsigned char bits[1 << DISPLAY_WIDTH];
+} mirror_table_t;
+
+static constexpr unsigned char ORIENTATIONS[] = DISPLAY_ORIENTATIONS;
+static_assert(sizeof(ORIENTATIONS) == NUM_DISPLAYS,
+              "DISPLAY_ORIENTATIONS must list every display");
+
+// Number of displays along each row (or column) of displays of the scan path
+#define CHAIN_LINE_LENGTH ((DISPLAY_CHAIN_COLUMNS) ? (DISPLAYS_Y) : (DISPLAYS_X))
+
+/**
+ * The row (or column) of displays the n-th display along the scan path is on,
+ * counted from the one the path enters.
+ */
+static constexpr int chain_line(int n) {
+	return n / CHAIN_LINE_LENGTH;
+}
+
+/**
+ * The position of the n-th display along the scan path's row (or column),
+ * counted from the side the path enters at.
+ */
+static constexpr int chain_along(int n) {
+	return (DISPLAY_CHAIN_SERPENTINE && (chain_line(n) & 1))
+	       ? CHAIN_LINE_LENGTH - 1 - (n % CHAIN_LINE_LENGTH)
+	       : n % CHAIN_LINE_LENGTH;
+}
+
+/**
+ * The coordinates (in displays, from the top-left) of the n-th display along
+ * the scan path.
+ */
+static constexpr int chain_display_x(int n) {
+	return DISPLAY_CHAIN_FROM_RIGHT
+	       ? DISPLAYS_X - 1 - (DISPLAY_CHAIN_COLUMNS ? chain_line(n) : chain_along(n))
+	       : (DISPLAY_CHAIN_COLUMNS ? chain_line(n) : chain_along(n));
+}
+static constexpr int chain_display_y(int n) {
+	return DISPLAY_CHAIN_FROM_BOTTOM
+	       ? DISPLAYS_Y - 1 - (DISPLAY_CHAIN_COLUMNS ? chain_along(n) : chain_line(n))
+	       : (DISPLAY_CHAIN_COLUMNS ? chain_along(n) : chain_line(n));
+}
+
+/**
+ * The source of a row register of the n-th display along the scan path.
+ */
+static constexpr scan_slot_t scan_slot(int row, int n) {
+	return {
+		(unsigned char)((chain_display_y(n) * DISPLAY_HEIGHT)
+		                + ((ORIENTATIONS[n] & DISPLAY_MIRROR_Y) ? DISPLAY_HEIGHT - 1 - row : row)),
+		(unsigned char)((DISPLAYS_X - 1 - chain_display_x(n)) * DISPLAY_WIDTH),
+		(unsigned char)((ORIENTATIONS[n] & DISPLAY_MIRROR_X) ? 1 : 0),
+	};
+}
+
+/**
+ * Reverse the order of the bottom n bits of a value.
+ */
+static constexpr unsigned char reverse_bits(unsigned int value, int n) {
+	return n ? (((value & 1u) << (n - 1)) | reverse_bits(value >> 1, n - 1)) : 0u;
+}
+
+// The integers 0 to N-1 as a template parameter pack for generating tables
+template <unsigned int... I> struct indices {};
+template <unsigned int N, unsigned int... I>
+struct make_indices : make_indices<N - 1, N - 1, I...> {};
+template <unsigned int... I>
+struct make_indices<0, I...> { typedef indices<I...> type; };
+
+template <unsigned int... I>
+static constexpr scan_path_t make_scan_path(indices<I...>) {
+	return {{ scan_slot(I / NUM_DISPLAYS, NUM_DISPLAYS - 1 - (I % NUM_DISPLAYS))... }};
+}
+
+template <unsigned int... I>
+static constexpr mirror_table_t make_mirror_table(indices<I...>) {
+	return {{ reverse_bits(I, DISPLAY_WIDTH)... }};
+}
+
+// For every row register of every display (in the order sent) where its pixels
+// come from in a frame.
+static constexpr scan_path_t SCAN_PATH PROGMEM =
+	make_scan_path(make_indices<DISPLAY_HEIGHT * NUM_DISPLAYS>::type());
+
+// The columns of a display in reverse order, for mirrored displays
+static constexpr mirror_table_t MIRROR PROGMEM =
+	make_mirror_table(make_indices<1 << DISPLAY_WIDTH>::type());
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Internal utility functions
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
- * Write the same value to the same register in all the displays.
+ * Write the same value to the same register in all the displays. Blocks until
+ * sent and so may only be used before the SPI interrupt is enabled.
  */
 void write_all_reg(int reg, int value) {
 	digitalWrite(nEN_PIN, LOW);
-	for (int i = 0; i < (DISPLAYS_X*DISPLAYS_Y); i++) {
+	for (int i = 0; i < NUM_DISPLAYS; i++) {
 		SPI.transfer(reg);
 		SPI.transfer(value);
 	}
@@ -45,6 +196,37 @@ void write_all_reg(int reg, int value) {
 }
 
 
+/**
+ * Add a register write to the transmit queue for one display (in scan-path
+ * order).
+ */
+static void queue_reg(int reg, int value) {
+	tx_buf[tx_len++] = reg;
+	tx_buf[tx_len++] = value;
+}
+
+
+/**
+ * Send the next byte of the queue, latching the displays at the end of each
+ * transfer.
+ */
+ISR(SPI_STC_vect) {
+	unsigned char pos = tx_pos + 1;
+	
+	if (pos % TRANSFER_BYTES == 0)
+		digitalWrite(nEN_PIN, HIGH);
+	
+	if (pos < tx_len) {
+		if (pos % TRANSFER_BYTES == 0)
+			digitalWrite(nEN_PIN, LOW);
+		tx_pos = pos;
+		SPDR = tx_buf[pos];
+	} else {
+		tx_busy = false;
+	}
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 // Public functions
 ////////////////////////////////////////////////////////////////////////////////
@@ -70,33 +252,107 @@ void display_begin(void) {
 	for (int row = 0; row < DISPLAY_HEIGHT; row++)
 		write_all_reg(REG_ROW(row), 0x00);
 	write_all_reg(REG_SHUTDOWN, NORMAL);
+	
+	// Record the state the displays have been left in
+	for (int i = 0; i < NUM_DISPLAYS; i++) {
+		shadow_intensity[i] = 0x0F;
+		display_intensity[i] = 0x0F;
+	}
+	for (int row = 0; row < DISPLAY_HEIGHT; row++)
+		for (int i = 0; i < NUM_DISPLAYS; i++)
+			shadow_rows[row][i] = 0x00;
+	
+	// From now on frames are sent by the SPI interrupt
+	tx_busy = false;
+	SPI.attachInterrupt();
+}
+
+
+bool display_busy(void) {
+	return tx_busy;
+}
+
+
+void display_wait(void) {
+	while (tx_busy)
+		yield();
+}
+
+
+void display_set_display_intensity(int display_x, int display_y, int intensity) {
+	for (int i = 0; i < NUM_DISPLAYS; i++) {
+		int n = NUM_DISPLAYS - 1 - i;
+		if (chain_display_x(n) == display_x && chain_display_y(n) == display_y)
+			display_intensity[i] = intensity;
+	}
 }
 
 
-void display_buf(const char *buf, int global_intensity) {
-	// Set display intensity
-	write_all_reg(REG_INTENSITY, global_intensity);
+void display_buf(const frame_t *buf, int global_intensity) {
+	// The queue can't be touched until the previous frame has gone
+	display_wait();
+	tx_len = 0;
+	
+	// Set the intensity of the displays whose intensity has changed (if any)
+	unsigned char intensities[NUM_DISPLAYS];
+	bool intensity_changed = false;
+	for (int i = 0; i < NUM_DISPLAYS; i++) {
+		intensities[i] = (global_intensity * (display_intensity[i] + 1)) >> 4;
+		intensity_changed |= intensities[i] != shadow_intensity[i];
+	}
+	if (intensity_changed) {
+		for (int i = 0; i < NUM_DISPLAYS; i++) {
+			if (intensities[i] != shadow_intensity[i]) {
+				queue_reg(REG_INTENSITY, intensities[i]);
+				shadow_intensity[i] = intensities[i];
+			} else {
+				queue_reg(REG_NOP, 0x00);
+			}
+		}
+	}
 	
 	// Load frame from buffer
 	for (int row = 0; row < DISPLAY_HEIGHT; row++) {
-		digitalWrite(nEN_PIN, LOW);
-		for (int display_y = 0; display_y < DISPLAYS_Y; display_y++) {
-			for (int display_x = 0; display_x < DISPLAYS_X; display_x++) {
-				unsigned char row_pixels = 0;
-				for (int col = 0; col < DISPLAY_WIDTH; col++) {
-					row_pixels <<= 1;
-					row_pixels |= buf[ ((display_y*DISPLAY_HEIGHT) + row)*WIDTH
-					                 + ((display_x*DISPLAY_WIDTH) + col)
-					                 ];
-				}
-				// Pad out non-existing pixels
-				row_pixels <<= 8 - DISPLAY_WIDTH;
-				
-				// Send to display
-				SPI.transfer(REG_ROW(row));
-				SPI.transfer(row_pixels);
+		// Assemble the row for every display, noting if any have changed
+		unsigned char row_pixels[NUM_DISPLAYS];
+		bool row_changed = false;
+		const scan_slot_t *slot = SCAN_PATH.slots[row];
+		for (int i = 0; i < NUM_DISPLAYS; i++, slot++) {
+			// Extract this display's columns from the row
+			frame_row_t frame_row = buf->rows[pgm_read_byte(&slot->row)];
+			unsigned char pixels = ( frame_row
+			                       >> pgm_read_byte(&slot->shift)
+			                       ) & ((1u << DISPLAY_WIDTH) - 1u);
+			if (pgm_read_byte(&slot->mirror))
+				pixels = pgm_read_byte(&MIRROR.bits[pixels]);
+			
+			// Pad out non-existing pixels
+			pixels <<= 8 - DISPLAY_WIDTH;
+			
+			row_pixels[i] = pixels;
+			row_changed |= pixels != shadow_rows[row][i];
+		}
+		
+		// Don't touch the SPI bus if no display needs this row updating
+		if (!row_changed)
+			continue;
+		
+		// Queue for the displays, displays whose row is unchanged get a NOP
+		for (int i = 0; i < NUM_DISPLAYS; i++) {
+			if (row_pixels[i] != shadow_rows[row][i]) {
+				queue_reg(REG_ROW(row), row_pixels[i]);
+				shadow_rows[row][i] = row_pixels[i];
+			} else {
+				queue_reg(REG_NOP, 0x00);
 			}
 		}
-		digitalWrite(nEN_PIN, HIGH);
+	}
+	
+	// Start sending the first byte, the interrupt handler sends the rest
+	if (tx_len) {
+		tx_busy = true;
+		tx_pos = 0;
+		digitalWrite(nEN_PIN, LOW);
+		SPDR = tx_buf[0];
 	}
 }
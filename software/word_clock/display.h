@@ -5,6 +5,8 @@
 #ifndef DISPLAY_H
 #define DISPLAY_H
 
+#include "frame.h"
+
 /**
  * Setup SPI hardware, send initial start-up commands to the display, come out of power down with
  * all registers blanked and intensity set to full.
@@ -14,8 +16,34 @@ void display_begin(void);
 
 /**
  * Shift a frame buffer image onto the display, and set the display intensity.
+ *
+ * A copy of what each display currently holds is kept and only rows (and
+ * intensities) which have changed since the last call are sent.
+ *
+ * The data is queued and sent in the background by the SPI interrupt. If the
+ * previous frame is still being sent, this waits for it to finish first. The
+ * frame buffer may be modified as soon as this function returns.
+ */
+void display_buf(const frame_t *buf, int global_intensity);
+
+/**
+ * Set the intensity of one display (numbered in displays from the top-left)
+ * relative to the rest, e.g. to dim one region of the face. The global
+ * intensity given to display_buf() is scaled by (intensity+1)/16 for this
+ * display so the default, 0xF, leaves it at the global intensity. Takes effect
+ * from the next call to display_buf().
+ */
+void display_set_display_intensity(int display_x, int display_y, int intensity);
+
+/**
+ * Is a frame still being sent to the displays?
+ */
+bool display_busy(void);
+
+/**
+ * Wait until the displays have received the last frame sent.
  */
-void display_buf(const char *buf, int global_intensity);
+void display_wait(void);
 
 
 #endif
@@ -0,0 +1,24 @@
+/**
+ * Automatically-generated dissolve pixel order.
+ *   gen_dissolve_order
+ */
+PROGMEM prog_uchar DISSOLVE_ORDER[210] = {
+	106, 197,  92,  54, 166,  60, 144,  97, 181,  65, 204,  68,
+	161, 175,  14, 179,  33,  86,  61,   6, 196,  49, 153, 136,
+	112,  88,  90,   4,  78,  66, 158, 128, 205,  63,  59,  99,
+	186,  71,  74,  82,  51, 140,  87,   8,  24,  48, 184, 190,
+	 69,  23,  20,  56, 169,  30, 115, 209, 164,  46, 103, 183,
+	 89, 137,  28, 163, 148, 143, 157,  39, 101, 178,  22,  18,
+	 19, 150,  21, 124, 174, 200, 207,  34, 135, 189, 129,  64,
+	 81, 201,   1, 127, 116, 185,  29, 165,  76, 194, 171, 114,
+	138,  26,  43,  57, 206, 182, 110, 117,  31, 195,  35,  94,
+	 72, 142, 147, 172,  11, 188, 111, 130, 126,  98, 170, 198,
+	162, 202,   2, 193,  55, 121, 118, 132,  38,  77,  95, 168,
+	 52, 122, 176,  91, 199,  16, 149, 152, 125,  13, 109,  44,
+	141, 155,  93,  62,  10, 167,  47, 102, 146,   7,  80,   0,
+	 12, 145,  36,  40,   9,  45, 105, 131, 134,  58,  41,  84,
+	154, 156,  42, 151, 187, 123,  75,  25,   5, 104, 192,  73,
+	191, 160, 120, 119,  32, 107,  53,  15, 177, 113, 180, 173,
+	159,  37, 100, 203,  67,  79, 208, 133,  17,  96,   3,  50,
+	139,  83,  27,  70,  85, 108,
+};
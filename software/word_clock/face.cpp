@@ -2,6 +2,7 @@
 
 #include "word_clock.h"
 #include "face.h"
+#include "frame.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 // Face bitmaps
@@ -58,17 +59,41 @@ static prog_uchar *EYE_BLINK = eyes_0_;
 static prog_uchar *NOSE = nose;
 
 
-static void overlay_bitmap(char *buf, prog_uchar *bitmap) {
+////////////////////////////////////////////////////////////////////////////////
+// Precomposed faces
+////////////////////////////////////////////////////////////////////////////////
+
+#include "face_table.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Internal functions
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Reverse the order of the bits in a byte.
+ */
+static unsigned char reverse_byte(unsigned char c) {
+	c = (c >> 4) | (c << 4);
+	c = ((c >> 2) & 0x33) | ((c & 0x33) << 2);
+	c = ((c >> 1) & 0x55) | ((c & 0x55) << 1);
+	return c;
+}
+
+
+/**
+ * OR a bitmap onto a frame. The bitmaps' rows are stored a byte at a time with
+ * the left-most pixel of each byte in its least significant bit.
+ */
+static void overlay_bitmap(frame_t *buf, prog_uchar *bitmap) {
 	const int width_bytes = (WIDTH+7)/8;
 	
 	for (int y = 0; y < HEIGHT; y++) {
-		for (int x_byte = 0; x_byte < width_bytes; x_byte++) {
-			unsigned char c = pgm_read_byte_near(bitmap + (y*width_bytes) + x_byte);
-			for (int x_bit = 0; x_bit < 8; x_bit++) {
-				int x = x_byte*8 + x_bit;
-				buf[y*WIDTH + x] |= (c >> x_bit) & 1;
-			}
-		}
+		// Assemble the row MSB-left and drop the padding on the right
+		uint16_t row = 0;
+		for (int x_byte = 0; x_byte < width_bytes; x_byte++)
+			row = (row << 8) | reverse_byte(pgm_read_byte_near(bitmap++));
+		buf->rows[y] |= row >> ((width_bytes * 8) - WIDTH);
 	}
 }
 
@@ -76,10 +101,24 @@ static void overlay_bitmap(char *buf, prog_uchar *bitmap) {
 // Public functions
 ////////////////////////////////////////////////////////////////////////////////
 
-void face(char *buf, int happiness, bool blink) {
+void face(frame_t *buf, int happiness, bool blink) {
+	int index = pgm_read_byte_near(&(FACE_INDEX[blink ? 1 : 0][happiness - FACE_MIN]));
+	
+	// Faces are cropped to FACE_NUM_ROWS rows starting at FACE_TOP, each row
+	// given by its index in FACE_ROWS.
+	for (int y = 0; y < HEIGHT; y++) {
+		int row = y - FACE_TOP;
+		if (row >= 0 && row < FACE_NUM_ROWS)
+			buf->rows[y] = pgm_read_word_near(FACE_ROWS + pgm_read_byte_near(&(FACE_FRAMES[index][row])));
+		else
+			buf->rows[y] = 0;
+	}
+}
+
+
+void face_compose(frame_t *buf, int happiness, bool blink) {
 	// Blank the frame
-	for (int i = 0; i < WIDTH*HEIGHT; i++)
-		buf[i] = 0;
+	frame_clear(buf);
 	
 	// Build up the face
 	overlay_bitmap(buf, NOSE);
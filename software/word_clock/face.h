@@ -5,6 +5,8 @@
 #ifndef FACE_H
 #define FACE_H
 
+#include "frame.h"
+
 
 /**
  * Minimum and maximum values for happiness of the face.
@@ -16,13 +18,19 @@
 /**
  * Load a face in the specified mood into the buffer.
  *
- * @param buf A buffer [HEIGHT][WIDTH].
+ * @param buf The frame buffer to render the face into.
  * @param happiness An integer in the range FACE_MIN to FACE_MAX inclusive where
  *                  FACE_MIN is very sad, 0 is neutral and FACE_MAX is very
  *                  happy.
  * @param blink If true, set the eyes to look like they're blinking, otherwise
  *              the eyes should be open.
  */
-void face(char *buf, int happiness, bool blink);
+void face(frame_t *buf, int happiness, bool blink);
+
+/**
+ * Build the same face as face() from its component bitmaps (slowly). Used to
+ * generate the table of precomposed faces face() copies from.
+ */
+void face_compose(frame_t *buf, int happiness, bool blink);
 
 #endif
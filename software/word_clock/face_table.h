@@ -0,0 +1,116 @@
+/**
+ * Automatically-generated packed precomposed face table.
+ *   gen_faces
+ */
+#define FACE_TOP 1
+#define FACE_NUM_ROWS 13
+PROGMEM prog_uint16_t FACE_ROWS[22] = {
+	0x0000, //   0 ...............
+	0x0630, //   1 ....##...##....
+	0x0C18, //   2 ...##.....##...
+	0x180C, //   3 ..##.......##..
+	0x0080, //   4 .......#.......
+	0x01C0, //   5 ......###......
+	0x0808, //   6 ...#.......#...
+	0x1004, //   7 ..#.........#..
+	0x0770, //   8 ....###.###....
+	0x1E3C, //   9 ..####...####..
+	0x07F0, //  10 ....#######....
+	0x0FF8, //  11 ...#########...
+	0x1084, //  12 ..#....#....#..
+	0x03E0, //  13 .....#####.....
+	0x3086, //  14 .##....#....##.
+	0x2082, //  15 .#.....#.....#.
+	0x1FFC, //  16 ..###########..
+	0x380E, //  17 .###.......###.
+	0x3FFE, //  18 .#############.
+	0x2002, //  19 .#...........#.
+	0x3C1E, //  20 .####.....####.
+	0x1224, //  21 ..#..#...#..#..
+};
+PROGMEM prog_uchar FACE_FRAMES[38][FACE_NUM_ROWS] = {
+	{ 0,  1,  2,  3,  0,  0,  4,  0,  5,  1,  6,  7,  0},
+	{ 0,  1,  2,  3,  0,  0,  4,  0,  4,  8,  6,  0,  0},
+	{ 0,  0,  9,  2,  0,  0,  4,  0,  0, 10,  6,  0,  0},
+	{ 0,  0,  9,  2,  0,  0,  4,  0,  0, 11,  6,  0,  0},
+	{ 2,  9,  9,  2,  0,  0,  4,  0,  0, 11,  0,  0,  0},
+	{ 2,  9,  9,  2,  0,  0,  4,  0,  6, 11,  0,  0,  0},
+	{ 2,  9,  9,  2,  0,  0,  4,  0,  6, 10,  0,  0,  0},
+	{ 2,  9,  9,  2,  0,  0,  4,  0,  6,  8,  4,  0,  0},
+	{ 2,  9,  9,  2,  0,  0,  4,  7,  6,  8,  4,  0,  0},
+	{ 2,  9,  9,  2,  0,  0,  4,  7,  6,  1,  5,  0,  0},
+	{ 2,  9,  9,  2,  0,  0, 12,  7,  6,  1,  5,  0,  0},
+	{ 2,  9,  9,  2,  0,  0, 12,  7,  6,  1, 13,  5,  0},
+	{ 2,  9,  0,  0,  0,  0, 14,  7,  2, 10, 13,  5,  0},
+	{ 2,  9,  0,  0,  0,  0, 15,  3, 11, 10, 10,  5,  4},
+	{ 2,  9,  0,  0,  0,  0, 15,  3, 16, 11, 10, 13,  4},
+	{ 2,  9,  0,  0,  0,  0, 15, 17, 18, 16, 11, 10, 13},
+	{ 2,  9,  0,  0,  0,  0, 15, 17, 18, 16, 16, 11, 13},
+	{ 2,  9,  0,  0,  0,  0, 15, 17, 18, 16, 16, 16, 11},
+	{ 2,  9,  0,  0,  0, 19, 14, 20, 18, 16, 16, 16, 11},
+	{ 2, 21, 21,  2,  0,  0,  4,  0,  5,  1,  6,  7,  0},
+	{ 2, 21, 21,  2,  0,  0,  4,  0,  4,  8,  6,  0,  0},
+	{ 2, 21, 21,  2,  0,  0,  4,  0,  0, 10,  6,  0,  0},
+	{ 2, 21, 21,  2,  0,  0,  4,  0,  0, 11,  6,  0,  0},
+	{ 2, 21, 21,  2,  0,  0,  4,  0,  0, 11,  0,  0,  0},
+	{ 2, 21, 21,  2,  0,  0,  4,  0,  6, 11,  0,  0,  0},
+	{ 2, 21, 21,  2,  0,  0,  4,  0,  6, 10,  0,  0,  0},
+	{ 2, 21, 21,  2,  0,  0,  4,  0,  6,  8,  4,  0,  0},
+	{ 2, 21, 21,  2,  0,  0,  4,  7,  6,  8,  4,  0,  0},
+	{ 2, 21, 21,  2,  0,  0,  4,  7,  6,  1,  5,  0,  0},
+	{ 2, 21, 21,  2,  0,  0, 12,  7,  6,  1,  5,  0,  0},
+	{ 2, 21, 21,  2,  0,  0, 12,  7,  6,  1, 13,  5,  0},
+	{ 2, 21, 21,  2,  0,  0, 14,  7,  2, 10, 13,  5,  0},
+	{ 2, 21, 21,  2,  0,  0, 15,  3, 11, 10, 10,  5,  4},
+	{ 2, 21, 21,  2,  0,  0, 15,  3, 16, 11, 10, 13,  4},
+	{ 2, 21, 21,  2,  0,  0, 15, 17, 18, 16, 11, 10, 13},
+	{ 2, 21, 21,  2,  0,  0, 15, 17, 18, 16, 16, 11, 13},
+	{ 2, 21, 21,  2,  0,  0, 15, 17, 18, 16, 16, 16, 11},
+	{ 2, 21, 21,  2,  0, 19, 14, 20, 18, 16, 16, 16, 11},
+};
+PROGMEM prog_uchar FACE_INDEX[2][20] = {
+	{ // Eyes open
+		  0, // -4
+		  1, // -3
+		  2, // -2
+		  3, // -1
+		  4, // 0
+		  5, // 1
+		  6, // 2
+		  7, // 3
+		  8, // 4
+		  9, // 5
+		 10, // 6
+		 11, // 7
+		 12, // 8
+		 13, // 9
+		 14, // 10
+		 15, // 11
+		 16, // 12
+		 16, // 13
+		 17, // 14
+		 18, // 15
+	},
+	{ // Blinking
+		 19, // -4
+		 20, // -3
+		 21, // -2
+		 22, // -1
+		 23, // 0
+		 24, // 1
+		 25, // 2
+		 26, // 3
+		 27, // 4
+		 28, // 5
+		 29, // 6
+		 30, // 7
+		 31, // 8
+		 32, // 9
+		 33, // 10
+		 34, // 11
+		 35, // 12
+		 35, // 13
+		 36, // 14
+		 37, // 15
+	},
+};
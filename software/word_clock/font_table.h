@@ -0,0 +1,768 @@
+/**
+ * Automatically-generated packed font.
+ *   gen_font
+ */
+#define FONT_FIRST_CHAR 0x20
+#define FONT_LAST_CHAR 0x7E
+#define FONT_DEFAULT_INDEX 94 // ' '
+#define FONT_MAX_COLUMNS 13
+PROGMEM prog_uchar FONT_ASCII_TO_INDEX[95] = {
+	0x5E, // ' '
+	0x00, // '!'
+	0x01, // '"'
+	0x02, // '#'
+	0x03, // '$'
+	0x04, // '%'
+	0x05, // '&'
+	0x06, // '''
+	0x07, // '('
+	0x08, // ')'
+	0x09, // '*'
+	0x0A, // '+'
+	0x0B, // ','
+	0x0C, // '-'
+	0x0D, // '.'
+	0x0E, // '/'
+	0x0F, // '0'
+	0x10, // '1'
+	0x11, // '2'
+	0x12, // '3'
+	0x13, // '4'
+	0x14, // '5'
+	0x15, // '6'
+	0x16, // '7'
+	0x17, // '8'
+	0x18, // '9'
+	0x19, // ':'
+	0x1A, // ';'
+	0x1B, // '<'
+	0x1C, // '='
+	0x1D, // '>'
+	0x1E, // '?'
+	0x1F, // '@'
+	0x20, // 'A'
+	0x21, // 'B'
+	0x22, // 'C'
+	0x23, // 'D'
+	0x24, // 'E'
+	0x25, // 'F'
+	0x26, // 'G'
+	0x27, // 'H'
+	0x28, // 'I'
+	0x29, // 'J'
+	0x2A, // 'K'
+	0x2B, // 'L'
+	0x2C, // 'M'
+	0x2D, // 'N'
+	0x2E, // 'O'
+	0x2F, // 'P'
+	0x30, // 'Q'
+	0x31, // 'R'
+	0x32, // 'S'
+	0x33, // 'T'
+	0x34, // 'U'
+	0x35, // 'V'
+	0x36, // 'W'
+	0x37, // 'X'
+	0x38, // 'Y'
+	0x39, // 'Z'
+	0x3A, // '['
+	0x3B, // '\'
+	0x3C, // ']'
+	0x3D, // '^'
+	0x3E, // '_'
+	0x3F, // '`'
+	0x40, // 'a'
+	0x41, // 'b'
+	0x42, // 'c'
+	0x43, // 'd'
+	0x44, // 'e'
+	0x45, // 'f'
+	0x46, // 'g'
+	0x47, // 'h'
+	0x48, // 'i'
+	0x49, // 'j'
+	0x4A, // 'k'
+	0x4B, // 'l'
+	0x4C, // 'm'
+	0x4D, // 'n'
+	0x4E, // 'o'
+	0x4F, // 'p'
+	0x50, // 'q'
+	0x51, // 'r'
+	0x52, // 's'
+	0x53, // 't'
+	0x54, // 'u'
+	0x55, // 'v'
+	0x56, // 'w'
+	0x57, // 'x'
+	0x58, // 'y'
+	0x59, // 'z'
+	0x5A, // '{'
+	0x5B, // '|'
+	0x5C, // '}'
+	0x5D, // '~'
+};
+PROGMEM prog_uint16_t FONT_COLUMNS[176] = {
+	0x0000, //   0 ..............
+	0x067E, //   1 .######..##...
+	0x001E, //   2 .####.........
+	0x0080, //   3 .......#......
+	0x0090, //   4 ....#..#......
+	0x0790, //   5 ....#..####...
+	0x00F8, //   6 ...#####......
+	0x009E, //   7 .####..#......
+	0x00F0, //   8 ....####......
+	0x0010, //   9 ....#.........
+	0x0238, //  10 ...###...#....
+	0x0424, //  11 ..#..#....#...
+	0x0444, //  12 ..#...#...#...
+	0x1FFF, //  13 #############.
+	0x0284, //  14 ..#....#.#....
+	0x0388, //  15 ...#...###....
+	0x003C, //  16 ..####........
+	0x0042, //  17 .#....#.......
+	0x0662, //  18 .#...##..##...
+	0x013C, //  19 ..####..#.....
+	0x00C0, //  20 ......##......
+	0x0030, //  21 ....##........
+	0x03C8, //  22 ...#..####....
+	0x0426, //  23 .##..#....#...
+	0x0420, //  24 .....#....#...
+	0x0660, //  25 .....##..##...
+	0x03C0, //  26 ......####....
+	0x01C0, //  27 ......###.....
+	0x022C, //  28 ..##.#...#....
+	0x0412, //  29 .#..#.....#...
+	0x0422, //  30 .#...#....#...
+	0x0442, //  31 .#....#...#...
+	0x0484, //  32 ..#....#..#...
+	0x0300, //  33 ........##....
+	0x0580, //  34 .......##.#...
+	0x0440, //  35 ......#...#...
+	0x01F8, //  36 ...######.....
+	0x0E06, //  37 .##......###..
+	0x0801, //  38 #..........#..
+	0x0606, //  39 .##......##...
+	0x0024, //  40 ..#..#........
+	0x0018, //  41 ...##.........
+	0x007E, //  42 .######.......
+	0x0020, //  43 .....#........
+	0x0040, //  44 ......#.......
+	0x07FC, //  45 ..#########...
+	0x0800, //  46 ...........#..
+	0x0600, //  47 .........##...
+	0x1800, //  48 ...........##.
+	0x0700, //  49 ........###...
+	0x00E0, //  50 .....###......
+	0x001C, //  51 ..###.........
+	0x0002, //  52 .#............
+	0x0204, //  53 ..#......#....
+	0x0402, //  54 .#........#...
+	0x030C, //  55 ..##....##....
+	0x0404, //  56 ..#.......#...
+	0x07FE, //  57 .##########...
+	0x0400, //  58 ..........#...
+	0x0602, //  59 .#.......##...
+	0x0582, //  60 .#.....##.#...
+	0x0482, //  61 .#.....#..#...
+	0x0464, //  62 ..#..##...#...
+	0x041C, //  63 ..###.....#...
+	0x0274, //  64 ..#.###..#....
+	0x01CC, //  65 ..##..###.....
+	0x00A0, //  66 .....#.#......
+	0x0098, //  67 ...##..#......
+	0x0084, //  68 ..#....#......
+	0x0082, //  69 .#.....#......
+	0x023E, //  70 .#####...#....
+	0x0222, //  71 .#...#...#....
+	0x01F0, //  72 ....#####.....
+	0x024C, //  73 ..##..#..#....
+	0x0242, //  74 .#....#..#....
+	0x03C4, //  75 ..#...####....
+	0x0302, //  76 .#......##....
+	0x00C2, //  77 .#....##......
+	0x0032, //  78 .#..##........
+	0x000E, //  79 .###..........
+	0x03DC, //  80 ..###.####....
+	0x0262, //  81 .#...##..#....
+	0x0272, //  82 .#..###..#....
+	0x039C, //  83 ..###..###....
+	0x0324, //  84 ..#..#..##....
+	0x0630, //  85 ....##...##...
+	0x0120, //  86 .....#..#.....
+	0x0210, //  87 ....#....#....
+	0x0408, //  88 ...#......#...
+	0x0004, //  89 ..#...........
+	0x06E2, //  90 .#...###.##...
+	0x0012, //  91 .#..#.........
+	0x01E0, //  92 .....####.....
+	0x0618, //  93 ...##....##...
+	0x0804, //  94 ..#........#..
+	0x09E4, //  95 ..#..####..#..
+	0x1312, //  96 .#..#...##..#.
+	0x1212, //  97 .#..#....#..#.
+	0x1122, //  98 .#...#..#...#.
+	0x0BF4, //  99 ..#.######.#..
+	0x0A04, // 100 ..#......#.#..
+	0x0118, // 101 ...##...#.....
+	0x0380, // 102 .......###....
+	0x008C, // 103 ..##...#......
+	0x0022, // 104 .#...#........
+	0x2000, // 105 .............#
+	0x3000, // 106 ............##
+	0x0FFE, // 107 .###########..
+	0x0070, // 108 ....###.......
+	0x0108, // 109 ...#....#.....
+	0x0304, // 110 ..#.....##....
+	0x0006, // 111 .##...........
+	0x0060, // 112 .....##.......
+	0x0180, // 113 .......##.....
+	0x0100, // 114 ........#.....
+	0x0008, // 115 ...#..........
+	0x0202, // 116 .#.......#....
+	0x0E04, // 117 ..#......###..
+	0x130C, // 118 ..##....##..#.
+	0x00E4, // 119 ..#..###......
+	0x033C, // 120 ..####..##....
+	0x021C, // 121 ..###....#....
+	0x0384, // 122 ..#....###....
+	0x01FE, // 123 .########.....
+	0x0200, // 124 .........#....
+	0x0038, // 125 ...###........
+	0x05C0, // 126 ......###.#...
+	0x0078, // 127 ...####.......
+	0x00B0, // 128 ....##.#......
+	0x00D0, // 129 ....#.##......
+	0x07C0, // 130 ......#####...
+	0x0502, // 131 .#......#.#...
+	0x040A, // 132 .#.#......#...
+	0x0406, // 133 .##.......#...
+	0x0FFF, // 134 ############..
+	0x0E00, // 135 .........###..
+	0x1000, // 136 ............#.
+	0x000C, // 137 ..##..........
+	0x0001, // 138 #.............
+	0x0390, // 139 ....#..###....
+	0x0448, // 140 ...#..#...#...
+	0x0248, // 141 ...#..#..#....
+	0x07F0, // 142 ....#######...
+	0x07FF, // 143 ###########...
+	0x0310, // 144 ....#...##....
+	0x0610, // 145 ....#....##...
+	0x0250, // 146 ....#.#..#....
+	0x0450, // 147 ....#.#...#...
+	0x0270, // 148 ....###..#....
+	0x0009, // 149 #..#..........
+	0x1610, // 150 ....#....##.#.
+	0x2408, // 151 ...#......#..#
+	0x2608, // 152 ...#.....##..#
+	0x3210, // 153 ....#....#..##
+	0x0FF8, // 154 ...#########..
+	0x07E0, // 155 .....######...
+	0x07FB, // 156 ##.########...
+	0x1FFB, // 157 ##.##########.
+	0x0608, // 158 ...#.....##...
+	0x07F8, // 159 ...########...
+	0x3FF8, // 160 ...###########
+	0x0488, // 161 ...#...#..#...
+	0x0288, // 162 ...#...#.#....
+	0x03FE, // 163 .#########....
+	0x03F8, // 164 ...#######....
+	0x0160, // 165 .....##.#.....
+	0x01A0, // 166 .....#.##.....
+	0x2018, // 167 ...##........#
+	0x2060, // 168 .....##......#
+	0x1380, // 169 .......###..#.
+	0x0508, // 170 ...#....#.#...
+	0x0428, // 171 ...#.#....#...
+	0x0418, // 172 ...##.....#...
+	0x0FBE, // 173 .#####.#####..
+	0x1001, // 174 #...........#.
+	0x3FFF, // 175 ##############
+};
+PROGMEM prog_uchar FONT_GLYPH_COLUMNS[692] = {
+	  0,  0,  1, // '!'
+	  0,  2,  0,  2, // '"'
+	  0,  3,  4,  5,  6,  7,  5,  8,  7,  4,  9, // '#'
+	  0, 10, 11, 12, 13, 12, 14, 15, // '$'
+	 16, 17, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, // '%'
+	  0, 27, 28, 29, 30, 31, 32, 33, 33, 34, 35, // '&'
+	  0,  2, // '''
+	  0, 36, 37, 38, // '('
+	  0, 38, 39, 36, // ')'
+	 40,  9, 41, 42, 41, 43, 40, // '*'
+	  0, 44, 44, 44, 44, 45, 44, 44, 44, 44, // '+'
+	  0, 46, 47, // ','
+	  0,  3,  3,  3,  3, // '-'
+	  0,  0, 47, // '.'
+	 48, 49, 50, 51, 52, // '/'
+	  0, 36, 53, 54, 54, 54, 55, 36, // '0'
+	  0,  0, 56, 54, 57, 58, 58, // '1'
+	  0, 56, 59, 60, 61, 62, 63, // '2'
+	  0, 53, 54, 30, 30, 30, 64, 65, // '3'
+	  0, 20, 66, 67, 68, 69, 57,  3, // '4'
+	  0, 70, 29, 29, 29, 29, 71, 27, // '5'
+	  0, 72, 73, 30, 30, 30, 74, 75, // '6'
+	  0, 52, 54, 76, 77, 78, 79, 52, // '7'
+	  0, 80, 81, 30, 30, 30, 82, 83, // '8'
+	  0, 10, 23, 31, 31, 74, 84,  6, // '9'
+	  0,  0, 85, // ':'
+	  0, 46, 85, // ';'
+	  0, 20, 20, 66, 86, 86, 87, 87, 87, 88, // '<'
+	  0,  4,  4,  4,  4,  4,  4,  4,  4,  4, // '='
+	  0, 88, 87, 87, 87, 86, 86, 66, 20, 20, // '>'
+	  0, 89, 52, 90, 91, 51, // '?'
+	  0, 92, 93, 94, 95, 96, 97, 97, 98, 99,100,101,  8, // '@'
+	 58,102,  8,103, 69,103,  8,102, 58, // 'A'
+	  0, 57, 30, 30, 30, 30, 30, 82, 83, // 'B'
+	  0,  8, 55, 53, 54, 54, 54, 54, 53, // 'C'
+	  0, 57, 54, 54, 54, 54, 54, 53, 55,  8, // 'D'
+	  0, 57, 30, 30, 30, 30, 30, 30, // 'E'
+	  0, 57,104,104,104,104,104, // 'F'
+	  0,  8, 55, 53, 54, 54, 54, 31, 31, 75, // 'G'
+	  0, 57, 43, 43, 43, 43, 43, 43, 57, // 'H'
+	  0, 57, // 'I'
+	105,106,107, // 'J'
+	  0, 57,  0,108,  4,109,110, 54, 58, // 'K'
+	  0, 57, 58, 58, 58, 58, 58, // 'L'
+	  0, 57,111, 41,112,113,114,112, 41,111, 57, // 'M'
+	  0, 57,111,115, 21, 20,114, 47, 57, // 'N'
+	  0,  8, 55,116, 54, 54, 54, 53, 55,  8, // 'O'
+	  0, 57, 17, 17, 17, 17, 40, 16, // 'P'
+	  0,  8, 55,116, 54, 54, 54,117,118,  8, // 'Q'
+	  0, 57, 17, 17, 17, 17,119,120, 58, // 'R'
+	  0,121, 11, 30, 31, 31, 74,122, // 'S'
+	 52, 52, 52, 52, 57, 52, 52, 52, 52, // 'T'
+	  0,123,124, 58, 58, 58, 58,124,123, // 'U'
+	 52, 51,112,102, 47,113,112, 51, 52, // 'V'
+	111,125, 26, 47,126, 16,111, 16, 26, 58,102,127,111, // 'W'
+	 54, 53,109,128,112,129,109, 39, 58, // 'X'
+	 52, 89, 41,112,130, 21, 41,111, // 'Y'
+	  0, 59,131, 61, 31, 30, 29,132,133, // 'Z'
+	  0,134, 38, 38, // '['
+	 52, 16, 27,135,136, // '\'
+	  0, 38, 38,134, // ']'
+	  0,  9,  9,137,111, 52,111,137,  9,  9, // '^'
+	105,105,105,105,105,105,105, // '_'
+	  0,  0,138, 52, // '`'
+	  0,139,140,140,140,141,142, // 'a'
+	  0,143, 87, 88, 88, 88,144, 92, // 'b'
+	  0, 92, 87, 88, 88, 88, 87, // 'c'
+	  0, 92,145, 88, 88, 88,144,143, // 'd'
+	  0, 92,146,140,140,140,147,148, // 'e'
+	115, 57,149,149, // 'f'
+	  0, 92,150,151,151,152,153,154, // 'g'
+	  0,143,  9,115,115,115, 41,155, // 'h'
+	  0,156, // 'i'
+	105,105,157, // 'j'
+	  0,143, 44, 20, 86, 87,158, // 'k'
+	  0,143, // 'l'
+	  0,159,  9,115,115, 41,142,  9,115,115,115,142, // 'm'
+	  0,159,  9,115,115,115, 41,155, // 'n'
+	  0, 92,145, 88, 88, 88,144, 92, // 'o'
+	  0,160, 87, 88, 88, 88,144, 92, // 'p'
+	  0, 92,145, 88, 88, 88,144,160, // 'q'
+	  0,159,  9,115,115, // 'r'
+	  0,148,140,140,161,162,144, // 's'
+	115,163, 88, 88, 88, // 't'
+	  0,164,124, 58, 58, 58,124,159, // 'u'
+	  0, 41, 50, 49, 58,102,112, 41, // 'v'
+	  0,125, 27, 47, 92,125, 26, 47, 92, 41, // 'w'
+	  0, 88, 87,165, 20,166,145, 88, // 'x'
+	  0,167,168,169,135,113,112, 41, // 'y'
+	  0,158,170,161,140,171,172, // 'z'
+	  0,  0, 44, 44,173,174,174, // '{'
+	  0,  0,175, // '|'
+	  0,  0,  0,174,174,173, 44, 44, // '}'
+	  0,  3, 44, 44, 44,  3,  3,  3,  3, 44, // '~'
+};
+PROGMEM prog_uint16_t FONT_GLYPH_COLUMNS_LOOKUP[96] = {
+	  0, // '!'
+	  3, // '"'
+	  7, // '#'
+	 18, // '$'
+	 26, // '%'
+	 38, // '&'
+	 49, // '''
+	 51, // '('
+	 55, // ')'
+	 59, // '*'
+	 66, // '+'
+	 76, // ','
+	 79, // '-'
+	 84, // '.'
+	 87, // '/'
+	 92, // '0'
+	100, // '1'
+	107, // '2'
+	114, // '3'
+	122, // '4'
+	130, // '5'
+	138, // '6'
+	146, // '7'
+	154, // '8'
+	162, // '9'
+	170, // ':'
+	173, // ';'
+	176, // '<'
+	186, // '='
+	196, // '>'
+	206, // '?'
+	212, // '@'
+	225, // 'A'
+	234, // 'B'
+	243, // 'C'
+	252, // 'D'
+	262, // 'E'
+	270, // 'F'
+	277, // 'G'
+	287, // 'H'
+	296, // 'I'
+	298, // 'J'
+	301, // 'K'
+	310, // 'L'
+	317, // 'M'
+	328, // 'N'
+	337, // 'O'
+	347, // 'P'
+	355, // 'Q'
+	365, // 'R'
+	374, // 'S'
+	382, // 'T'
+	391, // 'U'
+	400, // 'V'
+	409, // 'W'
+	422, // 'X'
+	431, // 'Y'
+	439, // 'Z'
+	448, // '['
+	452, // '\'
+	457, // ']'
+	461, // '^'
+	471, // '_'
+	478, // '`'
+	482, // 'a'
+	489, // 'b'
+	497, // 'c'
+	504, // 'd'
+	512, // 'e'
+	520, // 'f'
+	524, // 'g'
+	532, // 'h'
+	540, // 'i'
+	542, // 'j'
+	545, // 'k'
+	552, // 'l'
+	554, // 'm'
+	566, // 'n'
+	574, // 'o'
+	582, // 'p'
+	590, // 'q'
+	598, // 'r'
+	603, // 's'
+	610, // 't'
+	615, // 'u'
+	623, // 'v'
+	631, // 'w'
+	641, // 'x'
+	649, // 'y'
+	657, // 'z'
+	664, // '{'
+	671, // '|'
+	674, // '}'
+	682, // '~'
+	692, // ' '
+	692,
+};
+PROGMEM prog_uchar FONT_GLYPH_WIDTH[95] = {
+	 5, // '!'
+	 5, // '"'
+	12, // '#'
+	 9, // '$'
+	13, // '%'
+	12, // '&'
+	 3, // '''
+	 5, // '('
+	 5, // ')'
+	 7, // '*'
+	12, // '+'
+	 4, // ','
+	 5, // '-'
+	 4, // '.'
+	 5, // '/'
+	 9, // '0'
+	 9, // '1'
+	 9, // '2'
+	 9, // '3'
+	 9, // '4'
+	 9, // '5'
+	 9, // '6'
+	 9, // '7'
+	 9, // '8'
+	 9, // '9'
+	 5, // ':'
+	 5, // ';'
+	12, // '<'
+	12, // '='
+	12, // '>'
+	 7, // '?'
+	14, // '@'
+	 9, // 'A'
+	10, // 'B'
+	10, // 'C'
+	11, // 'D'
+	 9, // 'E'
+	 8, // 'F'
+	11, // 'G'
+	10, // 'H'
+	 3, // 'I'
+	 4, // 'J'
+	 9, // 'K'
+	 7, // 'L'
+	12, // 'M'
+	10, // 'N'
+	11, // 'O'
+	 9, // 'P'
+	11, // 'Q'
+	10, // 'R'
+	 9, // 'S'
+	 9, // 'T'
+	10, // 'U'
+	 9, // 'V'
+	13, // 'W'
+	 9, // 'X'
+	 9, // 'Y'
+	10, // 'Z'
+	 5, // '['
+	 5, // '\'
+	 5, // ']'
+	12, // '^'
+	 7, // '_'
+	 7, // '`'
+	 8, // 'a'
+	 9, // 'b'
+	 8, // 'c'
+	 9, // 'd'
+	 9, // 'e'
+	 4, // 'f'
+	 9, // 'g'
+	 9, // 'h'
+	 3, // 'i'
+	 4, // 'j'
+	 8, // 'k'
+	 3, // 'l'
+	13, // 'm'
+	 9, // 'n'
+	 9, // 'o'
+	 9, // 'p'
+	 9, // 'q'
+	 5, // 'r'
+	 8, // 's'
+	 5, // 't'
+	 9, // 'u'
+	 8, // 'v'
+	11, // 'w'
+	 8, // 'x'
+	 8, // 'y'
+	 8, // 'z'
+	 9, // '{'
+	 5, // '|'
+	 9, // '}'
+	12, // '~'
+	 4, // ' '
+};
+PROGMEM prog_uchar FONT_GLYPH_START[95] = {
+	 0, // '!'
+	 0, // '"'
+	 0, // '#'
+	 0, // '$'
+	 0, // '%'
+	 0, // '&'
+	 0, // '''
+	 0, // '('
+	 0, // ')'
+	 0, // '*'
+	 0, // '+'
+	 0, // ','
+	 0, // '-'
+	 0, // '.'
+	 0, // '/'
+	 0, // '0'
+	 0, // '1'
+	 0, // '2'
+	 0, // '3'
+	 0, // '4'
+	 0, // '5'
+	 0, // '6'
+	 0, // '7'
+	 0, // '8'
+	 0, // '9'
+	 0, // ':'
+	 0, // ';'
+	 0, // '<'
+	 0, // '='
+	 0, // '>'
+	 0, // '?'
+	 0, // '@'
+	 0, // 'A'
+	 0, // 'B'
+	 0, // 'C'
+	 0, // 'D'
+	 0, // 'E'
+	 0, // 'F'
+	 0, // 'G'
+	 0, // 'H'
+	 0, // 'I'
+	 1, // 'J'
+	 0, // 'K'
+	 0, // 'L'
+	 0, // 'M'
+	 0, // 'N'
+	 0, // 'O'
+	 0, // 'P'
+	 0, // 'Q'
+	 0, // 'R'
+	 0, // 'S'
+	 0, // 'T'
+	 0, // 'U'
+	 0, // 'V'
+	 0, // 'W'
+	 0, // 'X'
+	 0, // 'Y'
+	 0, // 'Z'
+	 0, // '['
+	 0, // '\'
+	 0, // ']'
+	 0, // '^'
+	 0, // '_'
+	 0, // '`'
+	 0, // 'a'
+	 0, // 'b'
+	 0, // 'c'
+	 0, // 'd'
+	 0, // 'e'
+	 0, // 'f'
+	 0, // 'g'
+	 0, // 'h'
+	 0, // 'i'
+	 1, // 'j'
+	 0, // 'k'
+	 0, // 'l'
+	 0, // 'm'
+	 0, // 'n'
+	 0, // 'o'
+	 0, // 'p'
+	 0, // 'q'
+	 0, // 'r'
+	 0, // 's'
+	 0, // 't'
+	 0, // 'u'
+	 1, // 'v'
+	 0, // 'w'
+	 1, // 'x'
+	 1, // 'y'
+	 0, // 'z'
+	 0, // '{'
+	 0, // '|'
+	 0, // '}'
+	 0, // '~'
+	 0, // ' '
+};
+PROGMEM prog_uchar FONT_GLYPH_END[95] = {
+	 5, // '!'
+	 5, // '"'
+	12, // '#'
+	 9, // '$'
+	13, // '%'
+	12, // '&'
+	 3, // '''
+	 5, // '('
+	 5, // ')'
+	 7, // '*'
+	12, // '+'
+	 4, // ','
+	 5, // '-'
+	 4, // '.'
+	 5, // '/'
+	 9, // '0'
+	 9, // '1'
+	 9, // '2'
+	 9, // '3'
+	 9, // '4'
+	 9, // '5'
+	 9, // '6'
+	 9, // '7'
+	 9, // '8'
+	 9, // '9'
+	 5, // ':'
+	 5, // ';'
+	12, // '<'
+	12, // '='
+	12, // '>'
+	 7, // '?'
+	14, // '@'
+	 9, // 'A'
+	10, // 'B'
+	10, // 'C'
+	11, // 'D'
+	 9, // 'E'
+	 8, // 'F'
+	11, // 'G'
+	10, // 'H'
+	 3, // 'I'
+	 4, // 'J'
+	 9, // 'K'
+	 7, // 'L'
+	12, // 'M'
+	10, // 'N'
+	11, // 'O'
+	 9, // 'P'
+	11, // 'Q'
+	10, // 'R'
+	 9, // 'S'
+	 9, // 'T'
+	10, // 'U'
+	 9, // 'V'
+	13, // 'W'
+	 9, // 'X'
+	 9, // 'Y'
+	10, // 'Z'
+	 5, // '['
+	 5, // '\'
+	 5, // ']'
+	12, // '^'
+	 7, // '_'
+	 7, // '`'
+	 8, // 'a'
+	 9, // 'b'
+	 8, // 'c'
+	 9, // 'd'
+	 9, // 'e'
+	 4, // 'f'
+	 9, // 'g'
+	 9, // 'h'
+	 3, // 'i'
+	 4, // 'j'
+	 8, // 'k'
+	 3, // 'l'
+	13, // 'm'
+	 9, // 'n'
+	 9, // 'o'
+	 9, // 'p'
+	 9, // 'q'
+	 5, // 'r'
+	 8, // 's'
+	 5, // 't'
+	 9, // 'u'
+	 8, // 'v'
+	11, // 'w'
+	 8, // 'x'
+	 8, // 'y'
+	 8, // 'z'
+	 9, // '{'
+	 5, // '|'
+	 9, // '}'
+	12, // '~'
+	 4, // ' '
+};
@@ -0,0 +1,24 @@
+#include "frame.h"
+
+void frame_clear(frame_t *buf) {
+	for (int y = 0; y < HEIGHT; y++)
+		buf->rows[y] = 0;
+}
+
+
+void frame_copy(frame_t *to, const frame_t *from) {
+	for (int y = 0; y < HEIGHT; y++)
+		to->rows[y] = from->rows[y];
+}
+
+
+void frame_or(frame_t *to, const frame_t *from) {
+	for (int y = 0; y < HEIGHT; y++)
+		to->rows[y] |= from->rows[y];
+}
+
+
+void frame_shift_left(frame_t *buf, int n) {
+	for (int y = 0; y < HEIGHT; y++)
+		buf->rows[y] = (buf->rows[y] << n) & FRAME_ROW_MASK;
+}
@@ -0,0 +1,72 @@
+/**
+ * A bit-packed 1-bit-per-pixel frame buffer.
+ *
+ * Each row of the display is stored in a single 16-bit word with the left-most
+ * pixel in the most significant used bit, i.e. a row reads like a binary number
+ * when written out. Operations on whole rows (clearing, shifting, overlaying)
+ * can thus be performed a word at a time.
+ */
+
+#ifndef FRAME_H
+#define FRAME_H
+
+#include <stdint.h>
+
+#include "word_clock.h"
+
+#if WIDTH > 16
+	#error "frame_row_t is too narrow for the display WIDTH"
+#endif
+
+typedef uint16_t frame_row_t;
+
+typedef struct {
+	frame_row_t rows[HEIGHT];
+} frame_t;
+
+// Mask of the bits of a row which correspond with pixels
+#define FRAME_ROW_MASK ((frame_row_t)((1ul << (WIDTH)) - 1ul))
+
+// The bit within a row corresponding to column x
+#define FRAME_COL_BIT(x) ((frame_row_t)(1u << ((WIDTH) - 1 - (x))))
+
+
+/**
+ * Get the value of the pixel at the given coordinate.
+ */
+static inline bool frame_get(const frame_t *buf, int x, int y) {
+	return buf->rows[y] & FRAME_COL_BIT(x);
+}
+
+/**
+ * Set the value of the pixel at the given coordinate.
+ */
+static inline void frame_set(frame_t *buf, int x, int y, bool value) {
+	if (value)
+		buf->rows[y] |= FRAME_COL_BIT(x);
+	else
+		buf->rows[y] &= ~FRAME_COL_BIT(x);
+}
+
+/**
+ * Set every pixel in the frame to zero.
+ */
+void frame_clear(frame_t *buf);
+
+/**
+ * Copy the contents of one frame into another.
+ */
+void frame_copy(frame_t *to, const frame_t *from);
+
+/**
+ * Overlay (OR) every lit pixel of one frame onto another.
+ */
+void frame_or(frame_t *to, const frame_t *from);
+
+/**
+ * Shift the contents of the frame n columns to the left, leaving zeros in the
+ * right-most n columns.
+ */
+void frame_shift_left(frame_t *buf, int n);
+
+#endif
@@ -0,0 +1,89 @@
+#include <Arduino.h>
+
+#include "frame_sched.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Internal state
+////////////////////////////////////////////////////////////////////////////////
+
+static struct {
+	// The time between frames (usec)
+	unsigned long period;
+	
+	// The time (micros()) at which the next frame is due
+	unsigned long next_frame;
+	
+	// The time (micros()) at which the current frame started rendering
+	unsigned long frame_start;
+	
+	frame_sched_stats_t stats;
+} state;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////////
+
+void frame_sched_begin(unsigned long period) {
+	state.period = period;
+	state.next_frame = micros();
+	frame_sched_reset_stats();
+}
+
+
+bool frame_sched_due(void) {
+	unsigned long now = micros();
+	
+	// Times are compared by their (signed) difference so that the scheduler
+	// survives micros() wrapping.
+	if ((long)(now - state.next_frame) < 0)
+		return false;
+	
+	state.frame_start = now;
+	
+	// Schedule the next frame in the next slot on the fixed grid which has not
+	// already passed.
+	state.next_frame += state.period;
+	while ((long)(now - state.next_frame) >= 0) {
+		state.next_frame += state.period;
+		state.stats.skipped++;
+	}
+	
+	return true;
+}
+
+
+void frame_sched_end(void) {
+	unsigned long now = micros();
+	unsigned long frame_time = now - state.frame_start;
+	
+	state.stats.frames++;
+	if (frame_time > state.stats.max_frame_time)
+		state.stats.max_frame_time = frame_time;
+	
+	if (frame_time > state.period) {
+		state.stats.overruns++;
+		state.stats.last_slack = 0;
+	} else {
+		state.stats.last_slack = state.period - frame_time;
+	}
+	
+	if (state.stats.last_slack < state.stats.min_slack)
+		state.stats.min_slack = state.stats.last_slack;
+}
+
+
+void frame_sched_get_stats(frame_sched_stats_t *stats) {
+	*stats = state.stats;
+}
+
+
+void frame_sched_reset_stats(void) {
+	state.stats.frames = 0;
+	state.stats.overruns = 0;
+	state.stats.skipped = 0;
+	state.stats.max_frame_time = 0;
+	state.stats.last_slack = 0;
+	state.stats.min_slack = state.period;
+}
@@ -0,0 +1,72 @@
+/**
+ * A fixed-rate frame scheduler for the main loop.
+ *
+ * The main loop spins, asking the scheduler whether a new frame is due. When
+ * one is, the frame is rendered and the scheduler informed when it has
+ * finished so that the time spent (and the time left to spare) can be
+ * recorded. Frames are scheduled on a fixed grid: a late frame does not delay
+ * those which follow it and frame slots which are missed entirely are skipped.
+ */
+
+#ifndef FRAME_SCHED_H
+#define FRAME_SCHED_H
+
+/**
+ * Frame timing statistics (all times in usec).
+ */
+typedef struct {
+	// Number of frames rendered
+	unsigned long frames;
+	
+	// Number of frames which finished after their deadline (i.e. took longer
+	// than the frame period).
+	unsigned long overruns;
+	
+	// Number of frame slots skipped entirely due to overruns
+	unsigned long skipped;
+	
+	// Time spent rendering the longest frame
+	unsigned long max_frame_time;
+	
+	// Time left before the deadline when the most recent frame finished (zero
+	// on an overrun)
+	unsigned long last_slack;
+	
+	// The smallest slack left by any frame
+	unsigned long min_slack;
+} frame_sched_stats_t;
+
+
+/**
+ * Start scheduling frames at a fixed rate. The first frame is due immediately.
+ *
+ * @param period The time (usec) between the start of consecutive frames.
+ */
+void frame_sched_begin(unsigned long period);
+
+/**
+ * Should be called repeatedly from the main loop.
+ *
+ * @returns true if a frame is due, in which case it should be rendered and
+ *          frame_sched_end called once it is complete.
+ */
+bool frame_sched_due(void);
+
+/**
+ * Record the completion of the frame started after frame_sched_due returned
+ * true.
+ */
+void frame_sched_end(void);
+
+/**
+ * Get the frame timing statistics gathered since frame_sched_begin or the
+ * last call to frame_sched_reset_stats.
+ */
+void frame_sched_get_stats(frame_sched_stats_t *stats);
+
+/**
+ * Reset the frame timing statistics.
+ */
+void frame_sched_reset_stats(void);
+
+#endif
@@ -0,0 +1,184 @@
+#include <Arduino.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "grey.h"
+#include "display.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Internal state
+////////////////////////////////////////////////////////////////////////////////
+
+// Timer2 counts at F_CPU/128 (8 usec per tick at 16 MHz)
+#define TIMER2_PRESCALE 128ul
+#define TIMER2_CS (_BV(CS22) | _BV(CS20))
+
+static struct {
+	// The frame being displayed and the next frame to display. The interrupt
+	// handler swaps them at the start of a cycle if a new frame is pending.
+	grey_frame_t frames[2];
+	grey_frame_t *volatile cur;
+	grey_frame_t *volatile next;
+	volatile bool next_pending;
+	
+	// The intensity of the current and next frames
+	volatile int cur_intensity;
+	volatile int next_intensity;
+	
+	// The bit-plane being displayed and the number of slots it has left
+	unsigned char plane;
+	unsigned char slots_left;
+	
+	volatile bool running;
+	
+	volatile unsigned long late_planes;
+} state;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Interrupt handler
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * Once every slot: move on to the next bit-plane once the current one has been
+ * displayed for its share of the cycle.
+ *
+ * Sending a plane (display_buf) takes a while with interrupts disabled. The
+ * LDR sampler timestamps its samples from Timer1 rather than when its handler
+ * runs so it is not disturbed by this.
+ */
+ISR(TIMER2_COMPA_vect) {
+	if (state.slots_left && --state.slots_left)
+		return;
+	
+	// If the last plane is still being sent, show it for another slot
+	if (display_busy()) {
+		state.late_planes++;
+		return;
+	}
+	
+	state.plane++;
+	if (state.plane >= GREY_BITS) {
+		state.plane = 0;
+		
+		if (state.next_pending) {
+			grey_frame_t *frame = state.cur;
+			state.cur = state.next;
+			state.next = frame;
+			state.cur_intensity = state.next_intensity;
+			state.next_pending = false;
+		}
+	}
+	
+	display_buf(&(state.cur->planes[state.plane]), state.cur_intensity);
+	state.slots_left = 1 << state.plane;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////////
+
+void grey_frame_clear(grey_frame_t *buf) {
+	for (int b = 0; b < GREY_BITS; b++)
+		frame_clear(&(buf->planes[b]));
+}
+
+
+int grey_frame_get(const grey_frame_t *buf, int x, int y) {
+	int level = 0;
+	for (int b = 0; b < GREY_BITS; b++)
+		if (frame_get(&(buf->planes[b]), x, y))
+			level |= 1 << b;
+	return level;
+}
+
+
+void grey_frame_set(grey_frame_t *buf, int x, int y, int level) {
+	for (int b = 0; b < GREY_BITS; b++)
+		frame_set(&(buf->planes[b]), x, y, level & (1 << b));
+}
+
+
+void grey_frame_blend(grey_frame_t *out, const frame_t *from, const frame_t *to, int level) {
+	for (int y = 0; y < HEIGHT; y++) {
+		frame_row_t both      = from->rows[y] & to->rows[y];
+		frame_row_t from_only = from->rows[y] & ~to->rows[y];
+		frame_row_t to_only   = to->rows[y] & ~from->rows[y];
+		
+		for (int b = 0; b < GREY_BITS; b++)
+			out->planes[b].rows[y] = both
+			                       | (((GREY_MAX - level) & (1 << b)) ? from_only : 0)
+			                       | ((level & (1 << b)) ? to_only : 0);
+	}
+}
+
+
+void grey_begin(void) {
+	state.cur = &(state.frames[0]);
+	state.next = &(state.frames[1]);
+	state.next_pending = false;
+	state.running = false;
+	state.late_planes = 0ul;
+	
+	// Timer2 in clear-timer-on-compare mode, wrapping every slot, stopped until
+	// there is something to show.
+	TIMSK2 = 0;
+	TCCR2A = _BV(WGM21);
+	TCCR2B = 0;
+	OCR2A = (GREY_SLOT_USEC * (F_CPU / TIMER2_PRESCALE / 1000ul) / 1000ul) - 1;
+}
+
+
+void grey_show(const grey_frame_t *buf, int global_intensity) {
+	// The next frame is not touched by the interrupt handler unless it is
+	// pending.
+	unsigned char old_sreg = SREG;
+	cli();
+	state.next_pending = false;
+	SREG = old_sreg;
+	
+	*state.next = *buf;
+	state.next_intensity = global_intensity;
+	state.next_pending = true;
+	
+	if (!state.running) {
+		// Start a new cycle on the next slot
+		state.plane = GREY_BITS - 1;
+		state.slots_left = 0;
+		state.running = true;
+		
+		TCNT2 = 0;
+		TIFR2 = _BV(OCF2A);
+		TIMSK2 = _BV(OCIE2A);
+		TCCR2B = TIMER2_CS;
+	}
+}
+
+
+void grey_stop(void) {
+	if (!state.running)
+		return;
+	
+	TCCR2B = 0;
+	TIMSK2 = 0;
+	state.running = false;
+	state.next_pending = false;
+	
+	display_wait();
+}
+
+
+bool grey_running(void) {
+	return state.running;
+}
+
+
+unsigned long grey_late_planes(void) {
+	unsigned char old_sreg = SREG;
+	cli();
+	unsigned long late = state.late_planes;
+	SREG = old_sreg;
+	return late;
+}
@@ -0,0 +1,90 @@
+/**
+ * Greyscale frames and an interrupt-driven bit angle modulation (BAM) engine
+ * which displays them.
+ *
+ * A greyscale frame is stored as GREY_BITS 1-bit-per-pixel bit-planes: plane b
+ * holds bit b of every pixel's level. The engine shows each plane in turn for
+ * a time proportional to its weight (1, 2, 4, ... slots), timed by Timer2, so
+ * each pixel is lit for a fraction of every cycle proportional to its level.
+ * Planes are sent with display_buf() and so only the rows which differ from
+ * the previous plane are sent over SPI.
+ */
+
+#ifndef GREY_H
+#define GREY_H
+
+#include "word_clock.h"
+#include "frame.h"
+
+// Number of bits per pixel
+#define GREY_BITS 3
+
+// Number of grey levels (0 being off and GREY_MAX fully lit)
+#define GREY_LEVELS (1 << (GREY_BITS))
+#define GREY_MAX ((GREY_LEVELS) - 1)
+
+// Duration (usec) of the shortest bit-plane (plane 0). Must be longer than it
+// takes to send a whole frame to the displays. A full cycle takes GREY_MAX
+// slots.
+#define GREY_SLOT_USEC 1000ul
+
+typedef struct {
+	frame_t planes[GREY_BITS];
+} grey_frame_t;
+
+
+/**
+ * Set every pixel in the frame to zero.
+ */
+void grey_frame_clear(grey_frame_t *buf);
+
+/**
+ * Get the level of the pixel at the given coordinate.
+ */
+int grey_frame_get(const grey_frame_t *buf, int x, int y);
+
+/**
+ * Set the level of the pixel at the given coordinate.
+ */
+void grey_frame_set(grey_frame_t *buf, int x, int y, int level);
+
+/**
+ * Produce a cross-fade between two 1-bit frames: pixels lit in only the 'to'
+ * frame are given the specified level, those lit only in the 'from' frame
+ * GREY_MAX minus it and those lit in both are fully lit.
+ */
+void grey_frame_blend(grey_frame_t *out, const frame_t *from, const frame_t *to, int level);
+
+
+/**
+ * Setup the timer used by the engine (which is left stopped).
+ */
+void grey_begin(void);
+
+/**
+ * Display a greyscale frame at the given intensity, starting the engine if it
+ * is not already running. The frame is copied and takes effect from the start
+ * of the next cycle. display_buf() must not be called while the engine is
+ * running.
+ */
+void grey_show(const grey_frame_t *buf, int global_intensity);
+
+/**
+ * Stop the engine, waiting for the displays to finish receiving the last
+ * bit-plane. The displays are left showing whichever bit-plane was last sent.
+ */
+void grey_stop(void);
+
+/**
+ * Is the engine running?
+ */
+bool grey_running(void);
+
+/**
+ * The number of times a bit-plane was delayed by a slot because the previous
+ * one was still being sent.
+ */
+unsigned long grey_late_planes(void);
+
+
+#endif
@@ -0,0 +1,117 @@
+#include <Arduino.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+#include "ldr_sampler.h"
+
+
+#define RING_MASK ((LDR_SAMPLER_RING_SIZE) - 1)
+
+// Timer1 counts at F_CPU/8 (2 MHz at 16 MHz)
+#define TIMER1_TICKS_PER_USEC (F_CPU / 8ul / 1000000ul)
+
+////////////////////////////////////////////////////////////////////////////////
+// Internal state
+////////////////////////////////////////////////////////////////////////////////
+
+static ldr_sample_t ring[LDR_SAMPLER_RING_SIZE];
+
+// Index of the next sample to be written (only modified by the interrupt
+// handler) and the next to be read (only modified by ldr_sampler_read). The
+// ring is empty when they are equal. Single bytes are used so that reads and
+// writes are atomic.
+static volatile unsigned char head;
+static volatile unsigned char tail;
+
+// Number of samples lost due to the ring being full
+static volatile unsigned long dropped;
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Interrupt handler
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * ADC conversion complete: record the sample.
+ */
+ISR(ADC_vect) {
+	// The conversion was triggered when Timer1 last wrapped: timestamp the
+	// sample with that moment rather than when this handler happens to run
+	// (which is delayed by the conversion and by any other interrupt handler
+	// running at the time, e.g. the greyscale engine's). Correct so long as the
+	// handler runs within a sample period of the trigger.
+	unsigned int ticks = TCNT1;
+	unsigned long time = micros() - (ticks / TIMER1_TICKS_PER_USEC);
+	
+	int value = ADC;
+	
+	// The conversion was triggered by the compare match B flag which must be
+	// cleared for the next compare match to trigger another conversion.
+	TIFR1 = _BV(OCF1B);
+	
+	unsigned char next_head = (head + 1) & RING_MASK;
+	if (next_head == tail) {
+		dropped++;
+		return;
+	}
+	
+	ring[head].time = time;
+	ring[head].value = value;
+	head = next_head;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////////
+
+void ldr_sampler_begin(int pin, unsigned long period) {
+	head = 0;
+	tail = 0;
+	dropped = 0ul;
+	
+	// Timer1 in clear-timer-on-compare mode counting at F_CPU/8 (2 MHz) and
+	// wrapping every period. Compare match B fires at the same moment.
+	TCCR1A = 0;
+	TCCR1B = 0;
+	TCNT1 = 0;
+	OCR1A = (period * TIMER1_TICKS_PER_USEC) - 1;
+	OCR1B = OCR1A;
+	TIMSK1 = 0;
+	TIFR1 = _BV(OCF1B);
+	
+	// ADC referenced to AVcc, triggered by Timer1 compare match B, with a
+	// 125 kHz ADC clock (i.e. ~100 usec per conversion).
+	ADMUX = _BV(REFS0) | (pin & 0x07);
+	ADCSRB = _BV(ADTS2) | _BV(ADTS0);
+	ADCSRA = _BV(ADEN) | _BV(ADATE) | _BV(ADIE) | _BV(ADIF)
+	       | _BV(ADPS2) | _BV(ADPS1) | _BV(ADPS0);
+	
+	// Start the timer
+	TCCR1B = _BV(WGM12) | _BV(CS11);
+}
+
+
+int ldr_sampler_read(ldr_sample_t *samples, int max_samples) {
+	int num_samples = 0;
+	unsigned char next_tail = tail;
+	unsigned char cur_head = head;
+	
+	while (num_samples < max_samples && next_tail != cur_head) {
+		samples[num_samples++] = ring[next_tail];
+		next_tail = (next_tail + 1) & RING_MASK;
+	}
+	
+	// Release the slots only once they've been copied
+	tail = next_tail;
+	return num_samples;
+}
+
+
+unsigned long ldr_sampler_dropped(void) {
+	unsigned char old_sreg = SREG;
+	cli();
+	unsigned long num_dropped = dropped;
+	SREG = old_sreg;
+	return num_dropped;
+}
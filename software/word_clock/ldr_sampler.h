@@ -0,0 +1,51 @@
+/**
+ * Background sampling of the LDR at a fixed rate.
+ *
+ * Timer1 periodically triggers an ADC conversion of the LDR and the ADC
+ * conversion complete interrupt pushes each reading, timestamped with the
+ * moment the conversion was triggered, into a ring buffer. The main loop
+ * drains the ring in batches. The interrupt handler is the only producer and
+ * the main loop the only consumer so no locking is required.
+ *
+ * Note that analogRead() must not be used once the sampler has been started.
+ */
+
+#ifndef LDR_SAMPLER_H
+#define LDR_SAMPLER_H
+
+// Number of samples buffered (must be a power of two, no more than 128)
+#define LDR_SAMPLER_RING_SIZE 32
+
+typedef struct {
+	// The time (micros()) at which the sample was taken, i.e. at which Timer1
+	// triggered the conversion
+	unsigned long time;
+	
+	// The ADC reading (0 - 1023)
+	int value;
+} ldr_sample_t;
+
+
+/**
+ * Start sampling an analogue pin.
+ *
+ * @param pin The analogue pin number to sample (e.g. 2 for A2).
+ * @param period The time (usec) between samples (at most 32767).
+ */
+void ldr_sampler_begin(int pin, unsigned long period);
+
+/**
+ * Take buffered samples from the ring, oldest first.
+ *
+ * @param samples Array to place the samples in.
+ * @param max_samples The maximum number of samples to take.
+ * @returns The number of samples taken.
+ */
+int ldr_sampler_read(ldr_sample_t *samples, int max_samples);
+
+/**
+ * The number of samples which have been lost because the ring was full.
+ */
+unsigned long ldr_sampler_dropped(void);
+
+#endif
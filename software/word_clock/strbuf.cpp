@@ -0,0 +1,66 @@
+#include <avr/pgmspace.h>
+
+#include "strbuf.h"
+
+
+void strbuf_init(strbuf_t *sb, char *buf, size_t size) {
+	sb->str = buf;
+	sb->len = 0;
+	sb->size = size;
+	sb->truncated = false;
+	buf[0] = '\0';
+}
+
+
+bool strbuf_append_char(strbuf_t *sb, char c) {
+	if (sb->len + 1 >= sb->size) {
+		sb->truncated = true;
+		return false;
+	}
+	
+	sb->str[sb->len++] = c;
+	sb->str[sb->len] = '\0';
+	return true;
+}
+
+
+bool strbuf_append(strbuf_t *sb, const char *str) {
+	for (; *str != '\0'; str++)
+		if (!strbuf_append_char(sb, *str))
+			return false;
+	return true;
+}
+
+
+bool strbuf_append_P(strbuf_t *sb, const char *str) {
+	char c;
+	while ((c = pgm_read_byte(str++)) != '\0')
+		if (!strbuf_append_char(sb, c))
+			return false;
+	return true;
+}
+
+
+bool strbuf_append_int(strbuf_t *sb, int number) {
+	// Work with the magnitude as an unsigned value so that the most negative
+	// number can be represented.
+	unsigned int magnitude = number;
+	if (number < 0) {
+		if (!strbuf_append_char(sb, '-'))
+			return false;
+		magnitude = -magnitude;
+	}
+	
+	// Generate the digits least-significant first
+	char digits[sizeof(int) * 3];
+	int num_digits = 0;
+	do {
+		digits[num_digits++] = '0' + (magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude);
+	
+	while (num_digits)
+		if (!strbuf_append_char(sb, digits[--num_digits]))
+			return false;
+	return true;
+}
@@ -0,0 +1,62 @@
+/**
+ * A bounded string builder which tracks the length of the string being built
+ * so appending doesn't need to search for the end of the string.
+ */
+
+#ifndef STRBUF_H
+#define STRBUF_H
+
+#include <stddef.h>
+
+typedef struct {
+	// The buffer the string is built in (always null terminated)
+	char *str;
+	
+	// Length of the string so far (excluding the terminator)
+	size_t len;
+	
+	// Size of the buffer (including the terminator)
+	size_t size;
+	
+	// Set if anything appended did not fit in the buffer
+	bool truncated;
+} strbuf_t;
+
+
+/**
+ * Start building a new (empty) string in the given buffer.
+ *
+ * @param buf The buffer to build the string in.
+ * @param size The size of the buffer in bytes (must be at least 1).
+ */
+void strbuf_init(strbuf_t *sb, char *buf, size_t size);
+
+/**
+ * Append a string (in RAM).
+ *
+ * @returns true if the string was appended in full, false if it was truncated.
+ */
+bool strbuf_append(strbuf_t *sb, const char *str);
+
+/**
+ * Append a string stored in program memory (e.g. using PSTR()).
+ *
+ * @returns true if the string was appended in full, false if it was truncated.
+ */
+bool strbuf_append_P(strbuf_t *sb, const char *str);
+
+/**
+ * Append a single character.
+ *
+ * @returns true if the character was appended, false if there was no space.
+ */
+bool strbuf_append_char(strbuf_t *sb, char c);
+
+/**
+ * Append an integer in decimal.
+ *
+ * @returns true if the number was appended in full, false if it was truncated.
+ */
+bool strbuf_append_int(strbuf_t *sb, int number);
+
+#endif
@@ -1,5 +1,8 @@
+#include <avr/pgmspace.h>
+
 #include "word_clock.h"
 #include "text.h"
+#include "frame.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 // Font selection
@@ -15,8 +18,49 @@
 //                      |  |   '-- Font name
 //                      |  '-- Number of LEDs high (rounded to multiple of 8)
 //                      '-- Height of font (0 - 14)
+//
+// and then packed into font_table.h using the host's gen_font ("make tables").
+// Each glyph is stored as a series of columns, each an index into a pool of
+// distinct columns, FONT_COLUMNS, whose bit y is display row y.
+
+#include "font_table.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Column ring
+////////////////////////////////////////////////////////////////////////////////
+
+// Rendered columns are kept in a circular ring of TEXT_RING_COLS columns,
+// stored as one word per display row. Column c of the message lives in bit
+// (TEXT_RING_COLS - 1 - (c % TEXT_RING_COLS)) of each row so that, as in a
+// frame, a row of the ring reads left-to-right from the most significant bit.
+// Scrolling just moves the offset of the visible window within the ring; only
+// newly exposed columns need rendering.
+typedef uint32_t text_ring_row_t;
+#define TEXT_RING_COLS 32
+
+#if WIDTH >= TEXT_RING_COLS
+	#error "The text column ring must be wider than the display"
+#endif
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+////////////////////////////////////////////////////////////////////////////////
+
+// The glyphs of the current and next characters are decoded from the font into
+// RAM once, on moving onto a character, so that rendering a column needs no
+// further font lookups.
+typedef struct {
+	// The glyph's metrics (see font_gen.py)
+	unsigned char width;
+	unsigned char start;
+	unsigned char end;
+	
+	// The glyph's columns. Columns beyond num_columns are blank.
+	unsigned char num_columns;
+	text_column_t columns[FONT_MAX_COLUMNS];
+} text_glyph_t;
 
-#include "font.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 // Internal state
@@ -35,94 +79,288 @@ static struct {
 	// The pixel column within the next character being displayed
 	unsigned int next_col;
 	
+	// The cached glyphs of the current and next characters
+	text_glyph_t glyphs[2];
+	text_glyph_t *this_glyph;
+	text_glyph_t *next_glyph;
+	
+	// The column of the current character from which the next character's
+	// columns overlap it (i.e. this glyph's end minus the next glyph's start)
+	unsigned int overlap_col;
+	
+	// The pre-rendered columns of the message (or NULL if the message is being
+	// rendered as it scrolls) and the number of columns in the message
+	const text_column_t *columns;
+	unsigned int num_columns;
+	
 	// Number of blank pixels printed at the end of the message
 	unsigned int blank_pixels;
+	
+	// The ring of rendered columns
+	text_ring_row_t ring[HEIGHT];
+	
+	// The message column shown at the left of the display
+	unsigned int offset;
+	
+	// The number of message columns rendered into the ring so far
+	unsigned int rendered;
 } state;
 
 
 ////////////////////////////////////////////////////////////////////////////////
-// Public functions
+// Internal functions
 ////////////////////////////////////////////////////////////////////////////////
 
-void text_start(const char *str) {
-	state.str = str;
+/**
+ * Get the index of a character's glyph in the font (defaulting to space if the
+ * character is not available).
+ */
+static unsigned int glyph_index(char c) {
+	unsigned char ascii = (unsigned char)c;
+	unsigned int index = 0xFF;
+	if (ascii >= FONT_FIRST_CHAR && ascii <= FONT_LAST_CHAR)
+		index = pgm_read_byte_near(FONT_ASCII_TO_INDEX + (ascii - FONT_FIRST_CHAR));
+	return (index == 0xFF) ? FONT_DEFAULT_INDEX : index;
+}
+
+
+/**
+ * Decode a character's glyph from the font into the cache.
+ */
+static void load_glyph(text_glyph_t *glyph, char c) {
+	unsigned int index = glyph_index(c);
+	glyph->width = pgm_read_byte_near(FONT_GLYPH_WIDTH + index);
+	glyph->start = pgm_read_byte_near(FONT_GLYPH_START + index);
+	glyph->end   = pgm_read_byte_near(FONT_GLYPH_END   + index);
+	
+	unsigned int first = pgm_read_word_near(FONT_GLYPH_COLUMNS_LOOKUP + index);
+	unsigned int last  = pgm_read_word_near(FONT_GLYPH_COLUMNS_LOOKUP + index + 1);
+	glyph->num_columns = last - first;
+	for (unsigned int col = 0; col < glyph->num_columns; col++)
+		glyph->columns[col] = pgm_read_word_near(FONT_COLUMNS + pgm_read_byte_near(FONT_GLYPH_COLUMNS + first + col));
+}
+
+
+/**
+ * Get a column of a cached glyph.
+ */
+static inline text_column_t glyph_column(const text_glyph_t *glyph, unsigned int col) {
+	return (col < glyph->num_columns) ? glyph->columns[col] : 0;
+}
+
+
+/**
+ * Load the glyph of the character after the current one into the cache (unless
+ * the end of the message has been reached).
+ */
+static void load_next_glyph(void) {
+	if (*(state.this_char) == '\0')
+		return;
+	
+	load_glyph(state.next_glyph, state.this_char[1]);
+	state.overlap_col = (unsigned int)state.this_glyph->end - (unsigned int)state.next_glyph->start;
+}
+
+
+/**
+ * Move on to the next character of the message.
+ */
+static void next_char(void) {
+	state.this_char++;
+	
+	text_glyph_t *glyph = state.this_glyph;
+	state.this_glyph = state.next_glyph;
+	state.next_glyph = glyph;
+	
+	load_next_glyph();
+}
+
+
+/**
+ * Begin rendering a string from its first column.
+ */
+static void start_glyphs(const char *str) {
 	state.this_char = str;
 	state.this_col = 0;
 	state.next_col = 0;
-	state.blank_pixels = 0;
+	
+	state.this_glyph = &(state.glyphs[0]);
+	state.next_glyph = &(state.glyphs[1]);
+	load_glyph(state.this_glyph, str[0]);
+	load_next_glyph();
 }
 
 
-bool text_next(char *buf) {
-	// Shift everything in the buffer one pixel to the left leaving a column of
-	// zeros on the right-hand-side.
-	for (int y = 0; y < HEIGHT; y++) {
-		for (int x = 0; x < WIDTH-1; x++) {
-			buf[(y*WIDTH) + x] = buf[(y*WIDTH) + x + 1];
-		}
-		buf[(y*WIDTH) + WIDTH - 1] = 0;
-	}
-	
-	// If we've reached the end of the string, generate blank pixels to fill the
-	// remainder before finishing.
+/**
+ * Render the next column of the message from its glyphs.
+ *
+ * @returns false if the end of the message has been reached (and the column
+ *          was not set).
+ */
+static bool next_column(text_column_t *column) {
+	// If we've reached the end of the string, there are no more columns.
 	if (*(state.this_char) == '\0')
-		return state.blank_pixels++ < WIDTH;
-	
-	// Get the character index in the font (default to space if character is not
-	// available)
-	unsigned int this_index = pgm_read_byte_near(FONT_ASCII_TO_INDEX + state.this_char[0]);
-	unsigned int next_index = pgm_read_byte_near(FONT_ASCII_TO_INDEX + state.this_char[1]);
-	if (this_index == 0xFF) this_index = pgm_read_byte_near(FONT_ASCII_TO_INDEX + ' ');
-	if (next_index == 0xFF) next_index = pgm_read_byte_near(FONT_ASCII_TO_INDEX + ' ');
-	
-	// Get the start address of the bitmap for this character
-	unsigned int this_bitmap = pgm_read_word_near(FONT_GLYPH_BITMAPS_LOOKUP + this_index);
-	unsigned int next_bitmap = pgm_read_word_near(FONT_GLYPH_BITMAPS_LOOKUP + next_index);
-	
-	unsigned int this_width = pgm_read_byte_near(FONT_GLYPH_WIDTH + this_index);
-	unsigned int this_end   = pgm_read_byte_near(FONT_GLYPH_END   + this_index);
-	unsigned int next_start = pgm_read_byte_near(FONT_GLYPH_START + next_index);
-	unsigned int next_end   = pgm_read_byte_near(FONT_GLYPH_END   + next_index);
-	
-	// Display current the column
-	for (int row_byte = 0; row_byte < FONT_HEIGHT/8; row_byte++) {
-		// The current character's line
-		unsigned char c = pgm_read_byte_near( FONT_GLYPH_BITMAPS
-		                                    + this_bitmap
-		                                    + (state.this_col * (FONT_HEIGHT/8))
-		                                    + row_byte
-		                                    );
-		
-		// Overlaid with the next character's overlapping columns
-		if (state.this_col >= this_end - next_start && state.next_col < next_end)
-			c |= pgm_read_byte_near( FONT_GLYPH_BITMAPS
-			                       + next_bitmap
-			                       + (state.next_col * (FONT_HEIGHT/8))
-			                       + row_byte
-			                       );
-		
-		// Render the pixels into the buffer
-		for (int row_bit = 0; row_bit < 8; row_bit++) {
-			// Get the pixel position (centering the font within the screen's height)
-			int row_pixel = row_byte*8 + row_bit + (((int)HEIGHT - (int)FONT_HEIGHT)/2);
-			if (row_pixel >= 0 && row_pixel < HEIGHT) {
-				buf[(row_pixel*WIDTH) + WIDTH - 1] = (c >> (7-row_bit)) & 1;
-			}
-		}
-	}
+		return false;
+	
+	// The current character's column overlaid with the next character's
+	// overlapping columns
+	text_column_t c = glyph_column(state.this_glyph, state.this_col);
+	bool overlapping = state.this_col >= state.overlap_col;
+	if (overlapping && state.next_col < state.next_glyph->end)
+		c |= glyph_column(state.next_glyph, state.next_col);
+	*column = c;
 	
 	// Advance through the columns
-	if (state.this_col >= this_end - next_start)
+	if (overlapping)
 		state.next_col++;
 	state.this_col++;
 	
 	// Move to the next character as required (possibly skipping the next
 	// character if it was already completely printed in the current pass).
-	while (state.this_col >= this_width && *(state.this_char) != '\0') {
-		state.this_char++;
+	while (state.this_col >= state.this_glyph->width && *(state.this_char) != '\0') {
+		next_char();
 		state.this_col = state.next_col;
 		state.next_col = 0;
 	}
 	
 	return true;
 }
+
+
+/**
+ * Render the next column of the ring, either from the message's glyphs or by
+ * copying it from the pre-rendered columns.
+ *
+ * @returns false if the end of the message has been reached and the column
+ *          rendered was blank.
+ */
+static bool render_column(void) {
+	unsigned int ring_col = state.rendered++;
+	text_ring_row_t col_bit = (text_ring_row_t)1u << (TEXT_RING_COLS - 1 - (ring_col % TEXT_RING_COLS));
+	
+	// Wipe the column's old contents
+	for (int y = 0; y < HEIGHT; y++)
+		state.ring[y] &= ~col_bit;
+	
+	text_column_t c;
+	if (state.columns) {
+		// The message starts WIDTH columns into the ring (columns before it are
+		// only rendered when seeking).
+		if (ring_col < WIDTH)
+			return true;
+		if (ring_col - WIDTH >= state.num_columns)
+			return false;
+		c = state.columns[ring_col - WIDTH];
+	} else if (!next_column(&c)) {
+		return false;
+	}
+	
+	// Render the pixels into the ring
+	for (int y = 0; y < HEIGHT; y++, c >>= 1)
+		if (c & 1)
+			state.ring[y] |= col_bit;
+	
+	return true;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////////
+
+void text_start(const char *str) {
+	state.str = str;
+	state.columns = NULL;
+	state.blank_pixels = 0;
+	start_glyphs(str);
+	
+	// The message starts just off the right-hand side of the display
+	for (int y = 0; y < HEIGHT; y++)
+		state.ring[y] = 0;
+	state.offset = 0;
+	state.rendered = WIDTH;
+}
+
+
+unsigned int text_start_prerendered( const char *str
+                                   , text_column_t *arena
+                                   , unsigned int arena_columns
+                                   ) {
+	text_start(str);
+	
+	// Render the whole message, counting its columns even if they don't all fit
+	unsigned int num_columns = 0;
+	text_column_t column;
+	while (next_column(&column)) {
+		if (num_columns < arena_columns)
+			arena[num_columns] = column;
+		num_columns++;
+	}
+	
+	state.num_columns = num_columns;
+	if (num_columns <= arena_columns)
+		state.columns = arena;
+	else
+		start_glyphs(str);
+	
+	return num_columns;
+}
+
+
+bool text_scroll(unsigned int columns) {
+	bool running = true;
+	
+	while (columns--) {
+		state.offset++;
+		
+		// Render the column which has just scrolled into view. Once the message
+		// has been exhausted, count off the blank columns until the display is
+		// empty.
+		if (state.rendered < state.offset + WIDTH)
+			if (!render_column())
+				running = state.blank_pixels++ < WIDTH;
+	}
+	
+	return running;
+}
+
+
+bool text_seek(unsigned int offset) {
+	// Without the pre-rendered columns, scroll from the start of the message
+	if (!state.columns) {
+		text_start(state.str);
+		return text_scroll(offset);
+	}
+	
+	// Render the window of columns visible at the offset (as scrolling there
+	// would have done).
+	state.offset = offset;
+	state.rendered = offset;
+	while (state.rendered < offset + WIDTH)
+		render_column();
+	
+	state.blank_pixels = (offset > state.num_columns) ? offset - state.num_columns : 0;
+	return state.blank_pixels <= WIDTH;
+}
+
+
+unsigned int text_offset(void) {
+	return state.offset;
+}
+
+
+void text_render(frame_t *buf) {
+	unsigned int rotate = state.offset % TEXT_RING_COLS;
+	for (int y = 0; y < HEIGHT; y++) {
+		text_ring_row_t row = state.ring[y];
+		row = (row << rotate) | (row >> ((TEXT_RING_COLS - rotate) % TEXT_RING_COLS));
+		buf->rows[y] = (frame_row_t)(row >> (TEXT_RING_COLS - WIDTH));
+	}
+}
+
+
+bool text_next(frame_t *buf) {
+	bool running = text_scroll(1);
+	text_render(buf);
+	return running;
+}
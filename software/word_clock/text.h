@@ -5,22 +5,77 @@
 #ifndef TEXT_H
 #define TEXT_H
 
+#include "frame.h"
+
+/**
+ * A column of rendered text, row y in bit y.
+ */
+typedef uint16_t text_column_t;
+
 /**
  * Specify the string to display, this string must remain valid for the full
  * duration of the animation (i.e. until text_next returns false).
  */
 void text_start(const char *str);
 
+/**
+ * As text_start but first render the whole string into the given arena so that
+ * scrolling just copies columns out of it. If the arena is too small, the
+ * string is instead rendered as it scrolls, as with text_start. The arena must
+ * remain valid for as long as the string.
+ *
+ * @param arena An array of arena_columns columns.
+ * @returns the exact width of the string in columns, whether or not it fitted
+ *          in the arena. The string has scrolled completely off the display
+ *          after this many columns plus WIDTH, i.e. text_next returns true that
+ *          many times.
+ */
+unsigned int text_start_prerendered( const char *str
+                                   , text_column_t *arena
+                                   , unsigned int arena_columns
+                                   );
+
+
+/**
+ * Scroll the text a number of columns to the left, rendering any columns which
+ * come into view. The display buffer is not touched: use text_render to draw
+ * the visible window.
+ *
+ * @returns true if the string is still being displayed, false otherwise.
+ */
+bool text_scroll(unsigned int columns);
+
+/**
+ * Scroll the text directly to the given offset (see text_offset), rendering the
+ * columns in view. This is quick if the text was pre-rendered, otherwise the
+ * text is scrolled from its start.
+ *
+ * @returns true if the string is still being displayed at that offset, false
+ *          otherwise.
+ */
+bool text_seek(unsigned int offset);
+
+/**
+ * Get the scroll offset of the text, i.e. the number of columns scrolled since
+ * text_start. The text initially starts just beyond the right of the display.
+ */
+unsigned int text_offset(void);
+
+/**
+ * Draw the currently visible window of the text into a display buffer
+ * (replacing its contents).
+ */
+void text_render(frame_t *buf);
 
 /**
- * Shift in the next column of character pixels.
+ * Scroll in the next column of character pixels.
  *
- * @param buf The display buffer to render the text into. The contents will be
- *            pushed off the left of the buffer as the text scrolls into view.
+ * @param buf The display buffer to render the text into. Its contents are
+ *            replaced by the visible window of the text.
  * @returns true if the string is still being displayed, false otherwise. The
  *          last frame will be all blank and undefined when this function
  *          returns false.
  */
-bool text_next(char *buf);
+bool text_next(frame_t *buf);
 
 #endif
@@ -0,0 +1,47 @@
+#include <avr/pgmspace.h>
+
+#include "word_clock.h"
+#include "time_mask.h"
+#include "frame.h"
+
+////////////////////////////////////////////////////////////////////////////////
+// Mask table
+////////////////////////////////////////////////////////////////////////////////
+
+// The table can be regenerated (e.g. after changing the letter mask or the
+// phrasing of the time) using:
+//
+//   cd ../host && make tables
+
+#include "time_mask_table.h"
+
+// Marks the end of a list of (row, bits) entries in TIME_MASK_DATA
+#define END_OF_MASK 0xFF
+
+
+/**
+ * OR a list of (row, bits) entries from TIME_MASK_DATA into the buffer.
+ */
+static void overlay_entries(frame_t *buf, unsigned int offset) {
+	const prog_uchar *entry = TIME_MASK_DATA + offset;
+	unsigned char row;
+	while ((row = pgm_read_byte_near(entry)) != END_OF_MASK) {
+		buf->rows[row] |= ((frame_row_t)pgm_read_byte_near(entry + 1) << 8)
+		                | pgm_read_byte_near(entry + 2);
+		entry += 3;
+	}
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////////
+
+void time_mask(frame_t *buf, int hours, int minutes) {
+	// Past the half-hour, the time is given relative to the next hour
+	int relative_hours = (minutes <= 30) ? hours : (hours + 1) % 24;
+	
+	frame_clear(buf);
+	overlay_entries(buf, pgm_read_word_near(TIME_MASK_HOURS + relative_hours));
+	overlay_entries(buf, pgm_read_word_near(TIME_MASK_MINUTES + minutes));
+}
@@ -0,0 +1,24 @@
+/**
+ * Precomputed word masks for showing the time.
+ */
+
+#ifndef TIME_MASK_H
+#define TIME_MASK_H
+
+#include "word_clock.h"
+#include "frame.h"
+
+/**
+ * Load the mask which shows the time as "it is ..." into a buffer. The result
+ * is identical to passing "it is " followed by the output of
+ * words_append_time() to words_set_mask() but is looked up from a table
+ * generated offline (see software/host/gen_time_masks.cpp) rather than built
+ * and searched for at runtime.
+ *
+ * @param buf The frame buffer to load the mask into.
+ * @param hours Number of hours on 24-hour clock (i.e. 0-23)
+ * @param minutes Number of minutes (i.e. 0-59)
+ */
+void time_mask(frame_t *buf, int hours, int minutes);
+
+#endif
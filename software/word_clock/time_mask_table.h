@@ -0,0 +1,507 @@
+/**
+ * Automatically-generated time mask table.
+ *   gen_time_masks
+ */
+PROGMEM prog_uchar TIME_MASK_DATA[1073] = {
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7E,
+	 2, 0x70, 0x00,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x7C, 0x00,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x78, 0x00,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x00, 0x70,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 4, 0x7C, 0x00,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x07, 0xC0,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 2, 0x00, 0xF0,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x00, 0x07,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 2, 0x1F, 0x80,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 4, 0x00, 0x3F,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 5, 0x7F, 0x80,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x7F, 0x80,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x00, 0x7F,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 4, 0x7F, 0xC0,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x07, 0xF8,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 2, 0x00, 0xFF,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 2, 0x70, 0x00,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x7C, 0x00,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x78, 0x00,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x00, 0x70,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 4, 0x7C, 0x00,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x07, 0xC0,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 2, 0x00, 0xF0,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 2, 0x00, 0xF0,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x07, 0xC0,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 4, 0x7C, 0x00,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x00, 0x70,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x78, 0x00,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x7C, 0x00,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 2, 0x70, 0x00,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 2, 0x00, 0xFF,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x07, 0xF8,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 4, 0x7F, 0xC0,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x00, 0x7F,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x7F, 0x80,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 5, 0x7F, 0x80,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 4, 0x00, 0x3F,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 2, 0x1F, 0x80,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x00, 0x07,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 2, 0x00, 0xF0,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x07, 0xC0,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 4, 0x7C, 0x00,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x00, 0x70,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 6, 0x78, 0x00,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 3, 0x7C, 0x00,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7E,
+	 2, 0x70, 0x00,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 1, 0x63, 0xF7,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 5, 0x00, 0x7F,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 1, 0x63, 0xF7,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x78, 0x00,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x0F, 0x7F,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x0F, 0x7F,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x0F, 0x7F,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x78, 0x00,
+	 7, 0x00, 0x7F,
+	 1, 0x60, 0x07,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 5, 0x00, 0x7F,
+	 1, 0x60, 0x00,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x00, 0x7F,
+	 1, 0x60, 0x07,
+	 0, 0x0C, 0x00,
+	0xFF,
+	 8, 0x0C, 0x00,
+	 7, 0x0F, 0x7F,
+	 1, 0x63, 0xF0,
+	 0, 0x0C, 0x00,
+	0xFF,
+	13, 0x03, 0x00,
+	 9, 0x00, 0x3C,
+	0xFF,
+	13, 0x03, 0x00,
+	 8, 0x00, 0x07,
+	0xFF,
+	13, 0x03, 0x00,
+	 9, 0x07, 0xE0,
+	0xFF,
+	13, 0x00, 0x06,
+	10, 0x00, 0x3F,
+	0xFF,
+	13, 0x00, 0x06,
+	10, 0x70, 0x00,
+	0xFF,
+	13, 0x00, 0x06,
+	10, 0x01, 0xC0,
+	0xFF,
+	13, 0x00, 0x06,
+	 9, 0x7C, 0x00,
+	0xFF,
+	13, 0x00, 0x06,
+	12, 0x78, 0x00,
+	0xFF,
+	13, 0x00, 0x06,
+	12, 0x07, 0x80,
+	0xFF,
+	13, 0x00, 0x06,
+	11, 0x00, 0x07,
+	0xFF,
+	13, 0x00, 0x06,
+	11, 0x07, 0xC0,
+	0xFF,
+	13, 0x00, 0x06,
+	10, 0x1F, 0x00,
+	0xFF,
+	13, 0x00, 0x06,
+	 9, 0x00, 0x3C,
+	0xFF,
+	13, 0x00, 0x06,
+	 8, 0x00, 0x07,
+	0xFF,
+	13, 0x00, 0x06,
+	 9, 0x07, 0xE0,
+	0xFF,
+	13, 0x03, 0x00,
+	10, 0x00, 0x3F,
+	0xFF,
+	13, 0x03, 0x00,
+	10, 0x70, 0x00,
+	0xFF,
+	13, 0x03, 0x00,
+	10, 0x01, 0xC0,
+	0xFF,
+	13, 0x03, 0x00,
+	 9, 0x7C, 0x00,
+	0xFF,
+	13, 0x03, 0x00,
+	12, 0x78, 0x00,
+	0xFF,
+	13, 0x03, 0x00,
+	12, 0x07, 0x80,
+	0xFF,
+	13, 0x03, 0x00,
+	11, 0x00, 0x07,
+	0xFF,
+	13, 0x03, 0x00,
+	11, 0x07, 0xC0,
+	0xFF,
+	13, 0x03, 0x00,
+	10, 0x1F, 0x00,
+	0xFF,
+};
+PROGMEM prog_uint16_t TIME_MASK_HOURS[24] = {
+	1010, // 'twelve am'
+	1017, // 'one am'
+	1024, // 'two am'
+	1031, // 'three am'
+	1038, // 'four am'
+	1045, // 'five am'
+	1052, // 'six am'
+	1059, // 'seven am'
+	1066, // 'eight am'
+	 905, // 'nine am'
+	 912, // 'ten am'
+	 919, // 'eleven am'
+	 926, // 'twelve pm'
+	 933, // 'one pm'
+	 940, // 'two pm'
+	 947, // 'three pm'
+	 954, // 'four pm'
+	 961, // 'five pm'
+	 968, // 'six pm'
+	 975, // 'seven pm'
+	 982, // 'eight pm'
+	 989, // 'nine pm'
+	 996, // 'ten pm'
+	1003, // 'eleven pm'
+};
+PROGMEM prog_uint16_t TIME_MASK_MINUTES[60] = {
+	   9, // 'it is '
+	   0, // 'it is one minute past '
+	 853, // 'it is two minutes past '
+	  16, // 'it is three minutes past '
+	  32, // 'it is four minutes past '
+	 801, // 'it is five minutes past '
+	  48, // 'it is six minutes past '
+	  64, // 'it is seven minutes past '
+	  80, // 'it is eight minutes past '
+	  96, // 'it is nine minutes past '
+	 112, // 'it is ten minutes past '
+	 128, // 'it is eleven minutes past '
+	 144, // 'it is twelve minutes past '
+	 160, // 'it is thirteen minutes past '
+	 176, // 'it is fourteen minutes past '
+	 749, // 'it is quarter past '
+	 192, // 'it is sixteen minutes past '
+	 208, // 'it is seventeen minutes past '
+	 224, // 'it is eighteen minutes past '
+	 240, // 'it is nineteen minutes past '
+	 827, // 'it is twenty minutes past '
+	 256, // 'it is twenty one minutes past '
+	 736, // 'it is twenty two minutes past '
+	 272, // 'it is twenty three minutes past '
+	 288, // 'it is twenty four minutes past '
+	 814, // 'it is twenty five minutes past '
+	 304, // 'it is twenty six minutes past '
+	 320, // 'it is twenty seven minutes past '
+	 336, // 'it is twenty eight minutes past '
+	 352, // 'it is twenty nine minutes past '
+	 775, // 'it is half past '
+	 368, // 'it is twenty nine minutes to '
+	 384, // 'it is twenty eight minutes to '
+	 400, // 'it is twenty seven minutes to '
+	 416, // 'it is twenty six minutes to '
+	 892, // 'it is twenty five minutes to '
+	 432, // 'it is twenty four minutes to '
+	 448, // 'it is twenty three minutes to '
+	 762, // 'it is twenty two minutes to '
+	 464, // 'it is twenty one minutes to '
+	 788, // 'it is twenty minutes to '
+	 480, // 'it is nineteen minutes to '
+	 496, // 'it is eighteen minutes to '
+	 512, // 'it is seventeen minutes to '
+	 528, // 'it is sixteen minutes to '
+	 866, // 'it is quarter to '
+	 544, // 'it is fourteen minutes to '
+	 560, // 'it is thirteen minutes to '
+	 576, // 'it is twelve minutes to '
+	 592, // 'it is eleven minutes to '
+	 608, // 'it is ten minutes to '
+	 624, // 'it is nine minutes to '
+	 640, // 'it is eight minutes to '
+	 656, // 'it is seven minutes to '
+	 672, // 'it is six minutes to '
+	 840, // 'it is five minutes to '
+	 688, // 'it is four minutes to '
+	 704, // 'it is three minutes to '
+	 879, // 'it is two minutes to '
+	 720, // 'it is one minute to '
+};
@@ -1,146 +1,361 @@
+#include <Arduino.h>
+#include <avr/pgmspace.h>
+
 #include "tween.h"
+#include "dissolve_order.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////
-// Internal state
+// Tweening functions (internal)
+//
+// Each is given the time elapsed since the start of the tween which is always
+// less than the duration of the tween.
 ////////////////////////////////////////////////////////////////////////////////
 
-static struct {
-	// The source/destination frames
-	const char *from;
-	const char *to;
-	
-	// The animation to use
-	tween_animation_t animation;
-	
-	// The duration to animate for
-	int duration;
-	
-	// The number of frames elapsed
-	int elapsed;
-} state;
+void tween_next_fade_from_black(const tween_t *tween, unsigned long elapsed, int *from_level, int *to_level) {
+	*from_level = 0;
+	*to_level = (elapsed * TWEEN_LEVEL_MAX) / tween->duration;
+}
 
 
-////////////////////////////////////////////////////////////////////////////////
-// Tweening functions (internal)
-////////////////////////////////////////////////////////////////////////////////
+void tween_next_fade_to_black(const tween_t *tween, unsigned long elapsed, int *from_level, int *to_level) {
+	*from_level = TWEEN_LEVEL_MAX - ((elapsed * TWEEN_LEVEL_MAX) / tween->duration);
+	*to_level = 0;
+}
 
-bool tween_next_cut(char const **buf, int *global_intensity) {
-	if (state.elapsed == 0) {
-		*buf = state.to;
-		*global_intensity = 0xF;
-		state.elapsed = 1;
-		return true;
+
+void tween_next_fade_through_black(const tween_t *tween, unsigned long elapsed, int *from_level, int *to_level) {
+	unsigned long half = tween->duration / 2;
+	if (elapsed < half) {
+		*from_level = TWEEN_LEVEL_MAX - ((elapsed * TWEEN_LEVEL_MAX) / half);
+		*to_level = 0;
 	} else {
-		return false;
+		*from_level = 0;
+		*to_level = ((elapsed - half) * TWEEN_LEVEL_MAX) / (tween->duration - half);
 	}
 }
 
 
-bool tween_next_fade_from_black(char const **buf, int *global_intensity) {
-	state.elapsed++;
-	
-	if (state.elapsed <= state.duration) {
-		*buf = state.to;
-		*global_intensity = (state.elapsed * 0xF) / state.duration;
-		return true;
-	} else {
-		// Prevent overflow
-		state.elapsed--;
-		return false;
-	}
+void tween_next_fade(const tween_t *tween, unsigned long elapsed, int *from_level, int *to_level) {
+	*to_level = (elapsed * (TWEEN_LEVEL_MAX + 1)) / tween->duration;
+	*from_level = TWEEN_LEVEL_MAX - *to_level;
 }
 
 
-bool tween_next_fade_to_black(char const **buf, int *global_intensity) {
-	state.elapsed++;
-	if (state.elapsed < state.duration) {
-		*buf = state.from;
-		*global_intensity = 0xF - ((state.elapsed * 0xF) / state.duration);
-		return true;
-	} else if (state.elapsed == state.duration) {
-		*buf = state.to;
-		*global_intensity = 0xF;
-		return true;
-	} else {
-		// Prevent overflow
-		state.elapsed--;
-		return false;
-	}
+/**
+ * Is the animation one which updates the tween's frame a step at a time?
+ */
+static bool tween_is_incremental(tween_animation_t animation) {
+	return animation >= TWEEN_WIPE_LEFT;
 }
 
 
-bool tween_next_fade_through_black(char const **buf, int *global_intensity) {
-	state.elapsed++;
-	if (state.elapsed < state.duration/2) {
-		*buf = state.from;
-		*global_intensity = 0xF - ((state.elapsed * 0xF) / (state.duration/2));
-		return true;
-	} else if (state.elapsed <= state.duration) {
-		*buf = state.to;
-		*global_intensity = ((state.elapsed - (state.duration/2)) * 0xF)
-		                    / (state.duration - (state.duration/2));
-		return true;
-	} else {
-		// Prevent overflow
-		state.elapsed--;
-		return false;
+/**
+ * Copy a single pixel of the ending frame into the tween's frame.
+ */
+static void tween_copy_pixel(tween_t *tween, int x, int y) {
+	frame_set(&tween->frame, x, y, frame_get(tween->to, x, y));
+}
+
+
+/**
+ * Copy a column of the ending frame into the tween's frame.
+ */
+static void tween_copy_column(tween_t *tween, int x) {
+	frame_row_t bit = FRAME_COL_BIT(x);
+	for (int y = 0; y < HEIGHT; y++)
+		tween->frame.rows[y] = (tween->frame.rows[y] & ~bit) | (tween->to->rows[y] & bit);
+}
+
+
+/**
+ * Apply the next step of an incremental animation to the tween's frame.
+ */
+static void tween_step(tween_t *tween) {
+	unsigned int step = tween->steps++;
+	switch (tween->animation) {
+		case TWEEN_WIPE_LEFT:  tween_copy_column(tween, WIDTH - 1 - step); break;
+		case TWEEN_WIPE_RIGHT: tween_copy_column(tween, step); break;
+		case TWEEN_WIPE_UP:    tween->frame.rows[HEIGHT - 1 - step] = tween->to->rows[HEIGHT - 1 - step]; break;
+		case TWEEN_WIPE_DOWN:  tween->frame.rows[step] = tween->to->rows[step]; break;
+		
+		case TWEEN_DISSOLVE: {
+			int pixel = pgm_read_byte_near(DISSOLVE_ORDER + step);
+			tween_copy_pixel(tween, pixel % WIDTH, pixel / WIDTH);
+			break;
+		}
+		
+		case TWEEN_REVEAL:
+			// Skip to the next pixel which differs. Should none be left (e.g. the
+			// ending frame was changed during the tween) the tween is complete.
+			while (tween->cursor < WIDTH * HEIGHT
+			       && frame_get(&tween->frame, tween->cursor % WIDTH, tween->cursor / WIDTH)
+			          == frame_get(tween->to, tween->cursor % WIDTH, tween->cursor / WIDTH))
+				tween->cursor++;
+			if (tween->cursor < WIDTH * HEIGHT) {
+				tween_copy_pixel(tween, tween->cursor % WIDTH, tween->cursor / WIDTH);
+				tween->cursor++;
+			} else {
+				tween->done = true;
+			}
+			break;
+		
+		default:
+			break;
 	}
 }
 
 
-bool tween_next_fade(char const **buf, int *global_intensity) {
-	state.elapsed++;
-	if (state.elapsed < state.duration) {
-		int duty = state.elapsed % TWEEN_FADE_DUTYCYCLE;
-		int phase = (state.elapsed * TWEEN_FADE_DUTYCYCLE) / state.duration;
-		if (duty > phase)
-			*buf = state.from;
-		else
-			*buf = state.to;
+/**
+ * The incremental animations: bring the tween's frame up to date by applying
+ * the steps due by now (the last step is left to the final frame).
+ */
+void tween_next_incremental(tween_t *tween, unsigned long elapsed, int *from_level, int *to_level) {
+	// Computed in ms since elapsed * num_steps would overflow in usec after a
+	// few seconds
+	unsigned int target = ((elapsed / 1000ul) * tween->num_steps) / (tween->duration / 1000ul);
+	while (!tween->done && tween->steps < target)
+		tween_step(tween);
+	
+	*from_level = 0;
+	*to_level = TWEEN_LEVEL_MAX;
+}
+
+
+/**
+ * The number of steps an incremental animation takes to get from the tween's
+ * starting frame to its ending frame.
+ */
+static unsigned int tween_count_steps(const tween_t *tween) {
+	switch (tween->animation) {
+		case TWEEN_WIPE_LEFT:
+		case TWEEN_WIPE_RIGHT:
+			return WIDTH;
 		
-		*global_intensity = 0xF;
-		return true;
-	} else if (state.elapsed == state.duration) {
-		*buf = state.to;
-		*global_intensity = 0xF;
-		return true;
-	} else {
-		// Prevent overflow
-		state.elapsed--;
-		return false;
+		case TWEEN_WIPE_UP:
+		case TWEEN_WIPE_DOWN:
+			return HEIGHT;
+		
+		case TWEEN_DISSOLVE:
+			return WIDTH * HEIGHT;
+		
+		case TWEEN_REVEAL: {
+			unsigned int num_changed = 0;
+			for (int y = 0; y < HEIGHT; y++)
+				for (frame_row_t changed = tween->frame.rows[y] ^ tween->to->rows[y];
+				     changed; changed &= changed - 1)
+					num_changed++;
+			return num_changed;
+		}
+		
+		default:
+			return 0;
 	}
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+// Compositing functions (internal)
+////////////////////////////////////////////////////////////////////////////////
+
+/**
+ * The rows of a bit-plane lit by a given tween level.
+ */
+static frame_row_t grey_plane_bits(int level, int plane) {
+	int grey_level = (level * GREY_LEVELS) / (TWEEN_LEVEL_MAX + 1);
+	return (grey_level & (1 << plane)) ? FRAME_ROW_MASK : 0;
+}
+
+
+/**
+ * Draw a frame of a tween into a greyscale frame (within the tween's mask).
+ */
+static void composite_layer( grey_frame_t *out
+                           , const tween_t *tween
+                           , int from_level
+                           , int to_level
+                           ) {
+	int both_level = (from_level + to_level < TWEEN_LEVEL_MAX) ? from_level + to_level : TWEEN_LEVEL_MAX;
+	for (int y = 0; y < HEIGHT; y++) {
+		frame_row_t from      = (tween->from && from_level) ? tween->from->rows[y] : 0;
+		frame_row_t to        = to_level ? tween_frame(tween)->rows[y] : 0;
+		frame_row_t both      = from & to;
+		frame_row_t from_only = from & ~to;
+		frame_row_t to_only   = to & ~from;
+		frame_row_t mask      = tween->mask ? tween->mask->rows[y] : FRAME_ROW_MASK;
+		
+		for (int b = 0; b < GREY_BITS; b++) {
+			frame_row_t bits = (both & grey_plane_bits(both_level, b))
+			                 | (from_only & grey_plane_bits(from_level, b))
+			                 | (to_only & grey_plane_bits(to_level, b));
+			out->planes[b].rows[y] = (out->planes[b].rows[y] & ~mask) | (bits & mask);
+		}
+	}
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // Public Functions
 ////////////////////////////////////////////////////////////////////////////////
 
-void tween_start( const char *from
-                , const char *to
+void tween_start( tween_t *tween
+                , const frame_t *from
+                , const frame_t *to
                 , tween_animation_t animation
-                , int duration
+                , unsigned long duration
                 ) {
-	state.from      = from;
-	state.to        = to;
-	state.animation = animation;
-	state.duration  = duration;
+	tween->from      = from;
+	tween->to        = to;
+	tween->mask      = NULL;
+	tween->animation = animation;
+	tween->duration  = (animation == TWEEN_CUT) ? 0 : duration * 1000ul;
+	
+	tween->start = micros();
+	tween->done = false;
 	
-	state.elapsed = 0;
+	if (tween_is_incremental(animation)) {
+		if (from)
+			frame_copy(&tween->frame, from);
+		else
+			frame_clear(&tween->frame);
+		tween->steps = 0;
+		tween->cursor = 0;
+		tween->num_steps = tween_count_steps(tween);
+	}
+}
+
+
+const frame_t *tween_frame(const tween_t *tween) {
+	return (tween_is_incremental(tween->animation) && !tween->done)
+	       ? &tween->frame
+	       : tween->to;
+}
+
+
+void tween_set_mask(tween_t *tween, const frame_t *mask) {
+	tween->mask = mask;
+}
+
+
+bool tween_running(const tween_t *tween) {
+	return !tween->done;
 }
 
 
-bool tween_next(char const **buf, int *global_intensity) {
-	switch (state.animation) {
-		case TWEEN_CUT:                return tween_next_cut(buf, global_intensity);
-		case TWEEN_FADE_FROM_BLACK:    return tween_next_fade_from_black(buf, global_intensity);
-		case TWEEN_FADE_TO_BLACK:      return tween_next_fade_to_black(buf, global_intensity);
-		case TWEEN_FADE_THROUGH_BLACK: return tween_next_fade_through_black(buf, global_intensity);
-		case TWEEN_FADE:               return tween_next_fade(buf, global_intensity);
+bool tween_next(tween_t *tween, int *from_level, int *to_level) {
+	if (tween->done)
+		return false;
+	
+	// Once the duration has passed, finish by showing the final frame exactly
+	// once (no matter how slowly the tween is being driven).
+	unsigned long elapsed = micros() - tween->start;
+	if (elapsed >= tween->duration) {
+		*from_level = 0;
+		*to_level = TWEEN_LEVEL_MAX;
+		tween->done = true;
+		return true;
+	}
+	
+	switch (tween->animation) {
+		case TWEEN_FADE_FROM_BLACK:    tween_next_fade_from_black(tween, elapsed, from_level, to_level);    break;
+		case TWEEN_FADE_TO_BLACK:      tween_next_fade_to_black(tween, elapsed, from_level, to_level);      break;
+		case TWEEN_FADE_THROUGH_BLACK: tween_next_fade_through_black(tween, elapsed, from_level, to_level); break;
+		case TWEEN_FADE:               tween_next_fade(tween, elapsed, from_level, to_level);               break;
+		
+		case TWEEN_WIPE_LEFT:
+		case TWEEN_WIPE_RIGHT:
+		case TWEEN_WIPE_UP:
+		case TWEEN_WIPE_DOWN:
+		case TWEEN_DISSOLVE:
+		case TWEEN_REVEAL:
+			tween_next_incremental(tween, elapsed, from_level, to_level);
+			break;
 		
 		default:
+			tween->done = true;
 			return false;
 	}
+	
+	return true;
+}
+
+
+void tween_compositor_init(tween_compositor_t *compositor) {
+	compositor->num_layers = 0;
+}
+
+
+bool tween_compositor_add(tween_compositor_t *compositor, tween_t *tween) {
+	if (compositor->num_layers >= TWEEN_MAX_LAYERS)
+		return false;
+	
+	compositor->layers[compositor->num_layers++] = tween;
+	return true;
+}
+
+
+void tween_compositor_remove(tween_compositor_t *compositor, tween_t *tween) {
+	int n = 0;
+	for (int i = 0; i < compositor->num_layers; i++)
+		if (compositor->layers[i] != tween)
+			compositor->layers[n++] = compositor->layers[i];
+	compositor->num_layers = n;
+}
+
+
+bool tween_compositor_next( tween_compositor_t *compositor
+                          , const frame_t **buf
+                          , const grey_frame_t **grey
+                          , int *global_intensity
+                          ) {
+	int from_levels[TWEEN_MAX_LAYERS];
+	int to_levels[TWEEN_MAX_LAYERS];
+	bool changed = false;
+	for (int i = 0; i < compositor->num_layers; i++) {
+		if (tween_next(compositor->layers[i], &from_levels[i], &to_levels[i])) {
+			changed = true;
+		} else {
+			// Finished tweens hold their final frame
+			from_levels[i] = 0;
+			to_levels[i] = TWEEN_LEVEL_MAX;
+		}
+	}
+	
+	if (!changed)
+		return false;
+	
+	*grey = NULL;
+	*global_intensity = TWEEN_LEVEL_MAX;
+	
+	// A single whole-display tween showing one frame is shown as it is, dimmed
+	// using the display's intensity. (A tween without a starting frame starts
+	// from black which is left to the blending below.)
+	if (compositor->num_layers == 1 && !compositor->layers[0]->mask) {
+		if (from_levels[0] == 0) {
+			*buf = tween_frame(compositor->layers[0]);
+			*global_intensity = to_levels[0];
+			return true;
+		} else if (to_levels[0] == 0 && compositor->layers[0]->from) {
+			*buf = compositor->layers[0]->from;
+			*global_intensity = from_levels[0];
+			return true;
+		}
+	}
+	
+	// Otherwise blend the tweens in greyscale
+	bool full = true;
+	grey_frame_clear(&compositor->grey);
+	for (int i = 0; i < compositor->num_layers; i++) {
+		composite_layer(&compositor->grey, compositor->layers[i], from_levels[i], to_levels[i]);
+		full = full && from_levels[i] == 0 && to_levels[i] == TWEEN_LEVEL_MAX;
+	}
+	
+	// When every tween is showing a single frame at full intensity the
+	// bit-planes are identical and any one may be shown as an ordinary frame.
+	if (full)
+		*buf = &compositor->grey.planes[0];
+	else
+		*grey = &compositor->grey;
+	
+	return true;
 }
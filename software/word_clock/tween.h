@@ -1,18 +1,24 @@
 /**
  * Library for generating animations between different frame buffers.
+ *
+ * Each tween's state is held in a caller-owned tween_t so any number may be
+ * run at once, each optionally confined to a region of the display by a mask.
+ * A compositor combines a stack of tweens into the frame to display.
  */
 
 #ifndef TWEEN_H
 #define TWEEN_H
 
 #include "word_clock.h"
+#include "frame.h"
+#include "grey.h"
 
 /**
  * Different tween animations available.
  */
 typedef enum {
-	// Immeate transition with no animation. Always lasts one frame. Does not
-	// need a starting frame.
+	// Immeate transition with no animation. Always lasts one frame (the
+	// duration is ignored). Does not need a starting frame.
 	TWEEN_CUT,
 	
 	// Fade in from black. Doesn't need a starting frame.
@@ -24,40 +30,174 @@ typedef enum {
 	// Fade from one frame to another via black.
 	TWEEN_FADE_THROUGH_BLACK,
 	
-	// Fade from one frame to another.
+	// Fade from one frame to another (using greyscale frames).
 	TWEEN_FADE,
+	
+	// The following animations change the displayed frame a few pixels at a
+	// time, only updating the pixels which change on each frame. If no starting
+	// frame is given, they start from black.
+	
+	// Wipe to the ending frame, the edge moving in the direction named.
+	TWEEN_WIPE_LEFT,
+	TWEEN_WIPE_RIGHT,
+	TWEEN_WIPE_UP,
+	TWEEN_WIPE_DOWN,
+	
+	// Switch every pixel to the ending frame, one at a time in a random order.
+	TWEEN_DISSOLVE,
+	
+	// Switch the pixels which differ between the frames, one at a time in
+	// reading order, i.e. hiding the letters which go and revealing the letters
+	// which arrive as if being written.
+	TWEEN_REVEAL,
 } tween_animation_t;
 
 
-// Number of frames over which to perform PWM during the fade tween (also
-// specifies the number of intensity levels that will be achieved).
-#define TWEEN_FADE_DUTYCYCLE 8
+// Maximum brightness level of the frames in a tween (i.e. full intensity)
+#define TWEEN_LEVEL_MAX 0xF
+
+// Maximum number of tweens a compositor can combine
+#define TWEEN_MAX_LAYERS 4
+
+
+/**
+ * The state of a tween.
+ */
+typedef struct {
+	// The source/destination frames
+	const frame_t *from;
+	const frame_t *to;
+	
+	// The pixels the tween affects (or NULL for the whole display)
+	const frame_t *mask;
+	
+	// The animation to use
+	tween_animation_t animation;
+	
+	// The duration to animate for (usec)
+	unsigned long duration;
+	
+	// The time (micros()) at which the tween started
+	unsigned long start;
+	
+	// Has the final frame been produced?
+	bool done;
+	
+	// For the incremental animations: the frame shown so far, the number of
+	// steps (e.g. columns or pixels) of the animation applied to it and the
+	// total number of steps.
+	frame_t frame;
+	unsigned int steps;
+	unsigned int num_steps;
+	
+	// For TWEEN_REVEAL: the index ((y * WIDTH) + x) of the next pixel to check
+	unsigned int cursor;
+} tween_t;
+
+
+/**
+ * A stack of tweens to be combined into a single frame.
+ */
+typedef struct {
+	// The tweens, bottom-most first
+	tween_t *layers[TWEEN_MAX_LAYERS];
+	int num_layers;
+	
+	// Greyscale frame produced when tweens must be blended
+	grey_frame_t grey;
+} tween_compositor_t;
 
 
 /**
- * Initialise the tween logic to begin a new tween between the given pair of
- * frames (assumed to be at full intensity).
+ * Begin a new tween between the given pair of frames (assumed to be at full
+ * intensity). The tween affects the whole display until a mask is set.
  *
+ * @param tween The tween to (re)start.
  * @param from The frame to start the tween from (which must remain constant
- *             throughout the tween) of size [HEIGHT][WIDTH].
+ *             throughout the tween) or NULL to start from black.
  * @param to The frame to end the tween on (which must remain constant
- *           throughout the tween) of size [HEIGHT][WIDTH].
+ *           throughout the tween and, if the tween is in a compositor, until
+ *           it is removed).
  * @param animation The animation to use.
- * @param duration The desired number of frames to animate for.
+ * @param duration The duration (ms) of the animation. The animation is timed
+ *                 using micros() and so is independent of how often
+ *                 tween_next is called.
  */
-void tween_start( const char *from
-                , const char *to
+void tween_start( tween_t *tween
+                , const frame_t *from
+                , const frame_t *to
                 , tween_animation_t animation
-                , int duration
+                , unsigned long duration
                 );
 
 /**
- * To be called repeatedly after tween_start has been called. This function
- * should be executed once per frame until it returns false at which point the
- * tween has been completed.
+ * The frame shown at the 'to' level by the latest frame of the tween (see
+ * tween_next). This is the ending frame except during the incremental
+ * animations.
+ */
+const frame_t *tween_frame(const tween_t *tween);
+
+/**
+ * Confine a tween to the pixels set in the given mask (which must remain
+ * constant while the tween is in use), or NULL for the whole display.
+ */
+void tween_set_mask(tween_t *tween, const frame_t *mask);
+
+/**
+ * Is the tween yet to produce its final frame?
+ */
+bool tween_running(const tween_t *tween);
+
+/**
+ * To be called repeatedly after tween_start has been called, once per frame,
+ * until it returns false at which point the tween has been completed. The
+ * final frame of the tween is always produced exactly once, even if the
+ * duration elapses between calls.
+ *
+ * A frame of the tween consists of the pixels lit in only the 'from' frame
+ * shown at one level, those lit in only the 'to' frame at another and those
+ * lit in both at the sum of the two (at most TWEEN_LEVEL_MAX).
  *
- * @param buf A double pointer to the buffer of size [HEIGHT][WIDTH] which will
- *            be displayed.
+ * @param from_level Set to the level (0 to TWEEN_LEVEL_MAX) of the 'from'
+ *                   frame.
+ * @param to_level Set to the level (0 to TWEEN_LEVEL_MAX) of the 'to' frame.
+ *
+ * @param returns true if a frame was produced and false otherwise. If false,
+ *                the levels may be invalid.
+ */
+bool tween_next(tween_t *tween, int *from_level, int *to_level);
+
+
+/**
+ * Initialise a compositor with no tweens.
+ */
+void tween_compositor_init(tween_compositor_t *compositor);
+
+/**
+ * Add a tween on top of the compositor's stack. Finished tweens keep showing
+ * their final frame (within their mask) until removed.
+ *
+ * @returns false if the stack is full.
+ */
+bool tween_compositor_add(tween_compositor_t *compositor, tween_t *tween);
+
+/**
+ * Remove a tween from the compositor's stack.
+ */
+void tween_compositor_remove(tween_compositor_t *compositor, tween_t *tween);
+
+/**
+ * To be called once per frame: advance every tween in the stack and combine
+ * them into the frame to be displayed, uppermost tweens taking precedence
+ * within their masks and pixels outside every mask being left dark.
+ *
+ * @param buf A double pointer to the frame buffer which will be displayed
+ *            (which may belong to the compositor and so only remains valid
+ *            until the next call).
+ *
+ * @param grey A double pointer which is set to a greyscale frame to display
+ *             (which remains valid until the next call) instead of buf, or
+ *             NULL if buf is to be displayed.
  *
  * @param global_intensity An integer which will have an intensity value in the
  *                         range 0x0-0xF which should be applied to all lit pixels
@@ -65,10 +205,15 @@ void tween_start( const char *from
  *                         0xF is maximum intensity. 0x0 may not be completely
  *                         off.
  *
- * @param returns true if a frame was produced and false otherwise. If false,
- *                the buffer and global_intensity values may be invalid.
+ * @param returns true if any tween produced a new frame and false otherwise.
+ *                If false, the buffer and global_intensity values may be
+ *                invalid.
  */
-bool tween_next(const char **buf, int *global_intensity);
+bool tween_compositor_next( tween_compositor_t *compositor
+                          , const frame_t **buf
+                          , const grey_frame_t **grey
+                          , int *global_intensity
+                          );
 
 
 #endif
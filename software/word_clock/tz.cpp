@@ -0,0 +1,149 @@
+#include <stdint.h>
+#include <avr/eeprom.h>
+
+#include "tz.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Internal functions
+////////////////////////////////////////////////////////////////////////////////
+
+#define SECS_PER_DAY  86400l
+#define SECS_PER_HOUR 3600l
+
+// Written before the rules saved in EEPROM (erased EEPROM reads as 0xFF)
+#define TZ_EEPROM_MARKER 0x7A
+
+/**
+ * The number of days between the epoch and the given date in the proleptic
+ * Gregorian calendar.
+ */
+static long days_from_civil(int year, int month, int day) {
+	// Count years from March so that the leap day is at the end of the year
+	if (month <= 2)
+		year--;
+	long era = (year >= 0 ? year : year - 399) / 400;
+	long year_of_era = year - era * 400;
+	long day_of_year = (153l * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+	long day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;
+	return era * 146097l + day_of_era - 719468l;
+}
+
+
+/**
+ * The year (Gregorian) containing the given day since the epoch.
+ */
+static int year_from_days(long days) {
+	days += 719468l;
+	long era = (days >= 0 ? days : days - 146096l) / 146097l;
+	long day_of_era = days - era * 146097l;
+	long year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;
+	long day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);
+	long month_index = (5 * day_of_year + 2) / 153;
+	int year = year_of_era + era * 400;
+	
+	// Years are counted from March
+	return (month_index >= 10) ? year + 1 : year;
+}
+
+
+/**
+ * The time (seconds since the epoch) at which a rule falls in a given year.
+ */
+static long rule_time(const tz_rule_t *rule, int year) {
+	long first = days_from_civil(year, rule->month, 1);
+	long next = (rule->month == 12) ? days_from_civil(year + 1, 1, 1)
+	                                : days_from_civil(year, rule->month + 1, 1);
+	
+	// The epoch was a Thursday (day 4 of a week starting on Sunday)
+	long first_sunday = first + (7 - ((first + 4) % 7)) % 7;
+	
+	long sunday = first_sunday + 7l * (rule->sunday - 1);
+	while (sunday >= next)
+		sunday -= 7;
+	
+	return sunday * SECS_PER_DAY + rule->hour * SECS_PER_HOUR;
+}
+
+
+/**
+ * Convert an EEPROM address into the pointer form avr-libc expects.
+ */
+static void *eeprom_ptr(int addr) {
+	return (void *)(uintptr_t)addr;
+}
+
+
+/**
+ * Is the rule within the ranges documented in tz_rule_t?
+ */
+static bool rule_valid(const tz_rule_t *rule) {
+	return rule->month >= 1 && rule->month <= 12
+	    && rule->sunday >= 1 && rule->sunday <= 5
+	    && rule->hour < 24;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////////
+
+void tz_init(tz_t *tz) {
+	tz->std_offset = 0;
+	tz->dst_offset = 0;
+	tz->dst_start.month = 1;
+	tz->dst_start.sunday = 1;
+	tz->dst_start.hour = 0;
+	tz->dst_end = tz->dst_start;
+}
+
+
+bool tz_valid(const tz_t *tz) {
+	return rule_valid(&tz->dst_start) && rule_valid(&tz->dst_end);
+}
+
+
+void tz_save(const tz_t *tz, int addr) {
+	unsigned char marker = TZ_EEPROM_MARKER;
+	eeprom_update_block(&marker, eeprom_ptr(addr), 1);
+	eeprom_update_block(tz, eeprom_ptr(addr + 1), sizeof(tz_t));
+}
+
+
+bool tz_load(tz_t *tz, int addr) {
+	unsigned char marker;
+	tz_t saved;
+	eeprom_read_block(&marker, eeprom_ptr(addr), 1);
+	eeprom_read_block(&saved, eeprom_ptr(addr + 1), sizeof(tz_t));
+	
+	if (marker != TZ_EEPROM_MARKER || !tz_valid(&saved))
+		return false;
+	
+	*tz = saved;
+	return true;
+}
+
+
+bool tz_is_dst(const tz_t *tz, time_t utc) {
+	if (tz->dst_offset == 0)
+		return false;
+	
+	long t = (long)utc;
+	int year = year_from_days(t / SECS_PER_DAY);
+	long start = rule_time(&tz->dst_start, year);
+	long end = rule_time(&tz->dst_end, year);
+	
+	if (start <= end)
+		return t >= start && t < end;
+	else
+		// DST spans the new year (e.g. in the southern hemisphere)
+		return t >= start || t < end;
+}
+
+
+time_t tz_local_time(const tz_t *tz, time_t utc) {
+	long offset = tz->std_offset;
+	if (tz_is_dst(tz, utc))
+		offset += tz->dst_offset;
+	return utc + offset * 60l;
+}
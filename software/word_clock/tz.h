@@ -0,0 +1,80 @@
+/**
+ * Conversion of UTC into local time according to a set of timezone and
+ * daylight saving time (DST) rules.
+ *
+ * DST is assumed to start and end on a given Sunday of a month at a given hour
+ * (UTC), which covers (for example) the rules used in Europe.
+ */
+
+#ifndef TZ_H
+#define TZ_H
+
+#include <Time.h>
+
+/**
+ * The moment DST starts or ends each year.
+ */
+typedef struct {
+	// Month (1-12)
+	unsigned char month;
+	
+	// Which Sunday of the month (1-4, 5 for the last)
+	unsigned char sunday;
+	
+	// Hour (UTC) on that Sunday
+	unsigned char hour;
+} tz_rule_t;
+
+typedef struct {
+	// Offset (minutes) of standard time from UTC
+	int std_offset;
+	
+	// Additional offset (minutes) while DST is in effect (0 if DST is not
+	// observed).
+	int dst_offset;
+	
+	tz_rule_t dst_start;
+	tz_rule_t dst_end;
+} tz_t;
+
+// Number of bytes of EEPROM used by tz_save: a marker byte followed by the
+// rules.
+#define TZ_EEPROM_SIZE (1 + sizeof(tz_t))
+
+
+/**
+ * Set the rules to UTC with no DST.
+ */
+void tz_init(tz_t *tz);
+
+/**
+ * Are the rules sensible, i.e. does each DST rule give a month (1-12), a
+ * Sunday (1-5) and an hour (0-23)? The conversions are meaningless otherwise.
+ */
+bool tz_valid(const tz_t *tz);
+
+/**
+ * Save the rules to EEPROM at the given address (occupying TZ_EEPROM_SIZE
+ * bytes) so that they survive a reset. Only bytes which differ are written.
+ */
+void tz_save(const tz_t *tz, int addr);
+
+/**
+ * Load rules previously saved with tz_save.
+ *
+ * @returns false (leaving tz untouched) if no valid rules (see tz_valid) were
+ *          saved at the address.
+ */
+bool tz_load(tz_t *tz, int addr);
+
+/**
+ * Is DST in effect at a given time?
+ */
+bool tz_is_dst(const tz_t *tz, time_t utc);
+
+/**
+ * Convert a UTC time (seconds since the epoch) into local time.
+ */
+time_t tz_local_time(const tz_t *tz, time_t utc);
+
+#endif
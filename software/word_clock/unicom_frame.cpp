@@ -0,0 +1,142 @@
+#include "unicom_frame.h"
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Decoder fields
+////////////////////////////////////////////////////////////////////////////////
+
+#define FIELD_MAGIC   0
+#define FIELD_TYPE    1
+#define FIELD_LENGTH  2
+#define FIELD_PAYLOAD 3
+#define FIELD_CRC_LO  4
+#define FIELD_CRC_HI  5
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Public functions
+////////////////////////////////////////////////////////////////////////////////
+
+uint16_t unicom_frame_crc(uint16_t crc, unsigned char byte) {
+	crc ^= (uint16_t)byte << 8;
+	for (int i = 0; i < 8; i++)
+		crc = (crc & 0x8000u) ? (crc << 1) ^ 0x1021u : (crc << 1);
+	return crc;
+}
+
+
+void unicom_frame_init(unicom_frame_decoder_t *dec) {
+	dec->field = FIELD_MAGIC;
+}
+
+
+unicom_frame_result_t unicom_frame_push(unicom_frame_decoder_t *dec, unsigned char byte) {
+	switch (dec->field) {
+		default:
+		case FIELD_MAGIC:
+			// Anything between frames is ignored
+			if (byte == UNICOM_FRAME_MAGIC) {
+				dec->crc = 0xFFFFu;
+				dec->field = FIELD_TYPE;
+			}
+			return UNICOM_FRAME_PENDING;
+		
+		case FIELD_TYPE:
+			dec->type = byte;
+			dec->crc = unicom_frame_crc(dec->crc, byte);
+			dec->field = FIELD_LENGTH;
+			return UNICOM_FRAME_PENDING;
+		
+		case FIELD_LENGTH:
+			if (byte > UNICOM_FRAME_MAX_PAYLOAD) {
+				dec->field = FIELD_MAGIC;
+				return UNICOM_FRAME_ERROR;
+			}
+			dec->length = byte;
+			dec->received = 0;
+			dec->crc = unicom_frame_crc(dec->crc, byte);
+			dec->field = byte ? FIELD_PAYLOAD : FIELD_CRC_LO;
+			return UNICOM_FRAME_PENDING;
+		
+		case FIELD_PAYLOAD:
+			dec->payload[dec->received++] = byte;
+			dec->crc = unicom_frame_crc(dec->crc, byte);
+			if (dec->received == dec->length)
+				dec->field = FIELD_CRC_LO;
+			return UNICOM_FRAME_PENDING;
+		
+		case FIELD_CRC_LO:
+			dec->frame_crc = byte;
+			dec->field = FIELD_CRC_HI;
+			return UNICOM_FRAME_PENDING;
+		
+		case FIELD_CRC_HI:
+			dec->frame_crc |= (uint16_t)byte << 8;
+			dec->field = FIELD_MAGIC;
+			return (dec->frame_crc == dec->crc) ? UNICOM_FRAME_OK : UNICOM_FRAME_ERROR;
+	}
+}
+
+
+bool unicom_frame_in_progress(const unicom_frame_decoder_t *dec) {
+	return dec->field != FIELD_MAGIC;
+}
+
+
+int unicom_frame_bytes_received(const unicom_frame_decoder_t *dec) {
+	switch (dec->field) {
+		default:
+		case FIELD_MAGIC:   return 0;
+		case FIELD_TYPE:    return 1;
+		case FIELD_LENGTH:  return 2;
+		case FIELD_PAYLOAD: return 3 + dec->received;
+		case FIELD_CRC_LO:  return 3 + dec->length;
+		case FIELD_CRC_HI:  return 4 + dec->length;
+	}
+}
+
+
+int unicom_frame_bytes_expected(const unicom_frame_decoder_t *dec) {
+	if (dec->field == FIELD_MAGIC || dec->field == FIELD_TYPE || dec->field == FIELD_LENGTH)
+		return UNICOM_FRAME_OVERHEAD;
+	else
+		return UNICOM_FRAME_OVERHEAD + dec->length;
+}
+
+
+size_t unicom_frame_encode( unsigned char *out
+                          , unicom_frame_type_t type
+                          , const unsigned char *payload
+                          , size_t length
+                          ) {
+	if (length > UNICOM_FRAME_MAX_PAYLOAD)
+		return 0;
+	
+	size_t n = 0;
+	out[n++] = UNICOM_FRAME_MAGIC;
+	out[n++] = type;
+	out[n++] = length;
+	for (size_t i = 0; i < length; i++)
+		out[n++] = payload[i];
+	
+	uint16_t crc = 0xFFFFu;
+	for (size_t i = 1; i < n; i++)
+		crc = unicom_frame_crc(crc, out[i]);
+	out[n++] = crc & 0xFF;
+	out[n++] = crc >> 8;
+	
+	return n;
+}
+
+
+uint32_t unicom_frame_u32(const unsigned char *field) {
+	return ((uint32_t)field[0])
+	     | ((uint32_t)field[1] << 8)
+	     | ((uint32_t)field[2] << 16)
+	     | ((uint32_t)field[3] << 24);
+}
+
+
+int16_t unicom_frame_s16(const unsigned char *field) {
+	return (int16_t)((uint16_t)field[0] | ((uint16_t)field[1] << 8));
+}
@@ -0,0 +1,146 @@
+/**
+ * Framing of the data sent over unicom.
+ *
+ * Each frame is sent as:
+ *
+ *   +-------+------+--------+-----------------+--------+
+ *   | MAGIC | TYPE | LENGTH | PAYLOAD         | CRC-16 |
+ *   +-------+------+--------+-----------------+--------+
+ *      1      1      1        LENGTH (0 - 64)    2
+ *
+ * The CRC is a CRC-16/CCITT-FALSE (polynomial 0x1021, initial value 0xFFFF)
+ * of the type, length and payload bytes. The CRC and all multi-byte payload
+ * fields are little-endian.
+ *
+ * Frames are decoded a byte at a time as they arrive. Anything which isn't a
+ * complete frame with a valid CRC is discarded so a sender may simply repeat
+ * frames to make delivery reliable.
+ */
+
+#ifndef UNICOM_FRAME_H
+#define UNICOM_FRAME_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// The byte which starts every frame
+#define UNICOM_FRAME_MAGIC 0x7E
+
+// The largest payload a frame may carry
+#define UNICOM_FRAME_MAX_PAYLOAD 64
+
+// The number of bytes in a frame in addition to its payload
+#define UNICOM_FRAME_OVERHEAD 5
+
+/**
+ * Frame types.
+ */
+typedef enum {
+	// The current time as seconds since the epoch (UTC), uint32_t.
+	UNICOM_FRAME_TIME = 0x01,
+	
+	// Timezone and daylight saving time rules (see tz.h):
+	//   int16_t  Offset of standard time from UTC (minutes)
+	//   int16_t  Additional offset during DST (minutes, 0 if not observed)
+	//   uint8_t  DST start month (1-12)
+	//   uint8_t  DST start Sunday of the month (1-4, 5 for the last)
+	//   uint8_t  DST start hour (UTC)
+	//   uint8_t  DST end month (1-12)
+	//   uint8_t  DST end Sunday of the month (1-4, 5 for the last)
+	//   uint8_t  DST end hour (UTC)
+	UNICOM_FRAME_TZ = 0x02,
+	
+	// A custom message of the day (ASCII, not null terminated). An empty message
+	// removes any custom message.
+	UNICOM_FRAME_MOTD = 0x03,
+	
+	// An opaque block of configuration data.
+	UNICOM_FRAME_CONFIG = 0x04,
+} unicom_frame_type_t;
+
+/**
+ * The result of passing a byte to the frame decoder.
+ */
+typedef enum {
+	// The byte was consumed, no frame is complete yet
+	UNICOM_FRAME_PENDING,
+	
+	// A frame has been received intact
+	UNICOM_FRAME_OK,
+	
+	// The frame being received was corrupt (bad length or CRC) and has been
+	// discarded
+	UNICOM_FRAME_ERROR,
+} unicom_frame_result_t;
+
+/**
+ * State of the frame decoder.
+ */
+typedef struct {
+	// The next field expected
+	unsigned char field;
+	
+	// The current frame's type and payload
+	unsigned char type;
+	unsigned char length;
+	unsigned char payload[UNICOM_FRAME_MAX_PAYLOAD];
+	
+	// Number of payload bytes received so far
+	unsigned char received;
+	
+	// The CRC of the frame so far and the CRC sent with the frame
+	uint16_t crc;
+	uint16_t frame_crc;
+} unicom_frame_decoder_t;
+
+
+/**
+ * Update a CRC-16/CCITT-FALSE with a byte.
+ */
+uint16_t unicom_frame_crc(uint16_t crc, unsigned char byte);
+
+/**
+ * Reset the decoder to wait for the start of a frame.
+ */
+void unicom_frame_init(unicom_frame_decoder_t *dec);
+
+/**
+ * Pass the next received byte to the decoder.
+ *
+ * @returns UNICOM_FRAME_OK when a frame has been completed, in which case its
+ *          type, length and payload are valid until the next call.
+ */
+unicom_frame_result_t unicom_frame_push(unicom_frame_decoder_t *dec, unsigned char byte);
+
+/**
+ * Is a frame part-way through being received?
+ */
+bool unicom_frame_in_progress(const unicom_frame_decoder_t *dec);
+
+/**
+ * The number of bytes of the current frame received so far and the total
+ * expected (which is a minimum until the length has been received).
+ */
+int unicom_frame_bytes_received(const unicom_frame_decoder_t *dec);
+int unicom_frame_bytes_expected(const unicom_frame_decoder_t *dec);
+
+/**
+ * Build a frame.
+ *
+ * @param out Buffer to write the frame into which must have space for
+ *            length + UNICOM_FRAME_OVERHEAD bytes.
+ * @returns The number of bytes written to out or 0 if the payload is too long.
+ */
+size_t unicom_frame_encode( unsigned char *out
+                          , unicom_frame_type_t type
+                          , const unsigned char *payload
+                          , size_t length
+                          );
+
+/**
+ * Read little-endian fields from a payload.
+ */
+uint32_t unicom_frame_u32(const unsigned char *field);
+int16_t unicom_frame_s16(const unsigned char *field);
+
+#endif
@@ -51,39 +51,79 @@
 #define WIDTH  ((DISPLAYS_X) * (DISPLAY_WIDTH))
 #define HEIGHT ((DISPLAYS_Y) * (DISPLAY_HEIGHT))
 
+// The order of the displays along the scan path. The path enters at a corner
+// (on the right if DISPLAY_CHAIN_FROM_RIGHT, at the bottom if
+// DISPLAY_CHAIN_FROM_BOTTOM) and runs along each row of displays in turn (or
+// each column if DISPLAY_CHAIN_COLUMNS). If DISPLAY_CHAIN_SERPENTINE, the
+// direction reverses on alternate rows (columns) rather than each starting on
+// the same side. The diagram above is thus:
+#define DISPLAY_CHAIN_FROM_RIGHT  1
+#define DISPLAY_CHAIN_FROM_BOTTOM 1
+#define DISPLAY_CHAIN_COLUMNS     0
+#define DISPLAY_CHAIN_SERPENTINE  0
+
+// Orientations a display may be mounted in
+#define DISPLAY_NORMAL     0x0
+#define DISPLAY_MIRROR_X   0x1 // Left and right swapped
+#define DISPLAY_MIRROR_Y   0x2 // Upside-down but not left and right swapped
+#define DISPLAY_ROTATE_180 ((DISPLAY_MIRROR_X) | (DISPLAY_MIRROR_Y))
+
+// The orientation of each display, in scan path order (the first being the
+// display the scan path enters).
+#define DISPLAY_ORIENTATIONS { \
+		DISPLAY_NORMAL, DISPLAY_NORMAL, DISPLAY_NORMAL, \
+		DISPLAY_NORMAL, DISPLAY_NORMAL, DISPLAY_NORMAL, \
+	}
+
+
+////////////////////////////////////////////////////////////////////////////////
+// Main loop timing
+////////////////////////////////////////////////////////////////////////////////
+
+// Time (usec) between frames of the UI (i.e. runs of the UI state machine and
+// display updates)
+#define FRAME_PERIOD_USEC 1000ul
+
+// Time (usec) between samples of the LDR by the unicom receiver (taken in the
+// background, independently of the frame rate)
+#define UNICOM_SAMPLE_PERIOD_USEC 500ul
+
+// Address in EEPROM of the timezone rules received via unicom
+#define TZ_EEPROM_ADDR 0
+
 
 ////////////////////////////////////////////////////////////////////////////////
 // UI Animation Timing
 ////////////////////////////////////////////////////////////////////////////////
 
-// Fames for fade-in of initial message
-#define RESET_MESSAGE_TWEEN_FRAMES 1000
+// Duration (ms) of the fade-in of initial message
+#define RESET_MESSAGE_TWEEN_MSEC 1000
 
 // Time (ms) to display the initial message
 #define RESET_MESSAGE_TIMEOUT_MSEC 5000
 
-// Frames for animation when starting to display the clock
-#define CLOCK_TWEEN_FRAMES 1000
+// Duration (ms) of animation when starting to display the clock
+#define CLOCK_TWEEN_MSEC 1000
 
-// Frames for animation when changing the clock time
-#define CLOCK_UPDATE_TWEEN_FRAMES 200
+// Duration (ms) of animation when changing the clock time
+#define CLOCK_UPDATE_TWEEN_MSEC 200
 
-// Frames for fading out animation of previous frame before displaying a
+// Duration (ms) of fading out animation of previous frame before displaying a
 // scrolling message
-#define SCROLL_MESSAGE_TWEEN_FRAMES 1000
+#define SCROLL_MESSAGE_TWEEN_MSEC 1000
 
 // Time (ms) between frames of a scrolling message
 #define SCROLLING_MESSAGE_FRAME_MSEC 100
 
-// Frames for animation when changing to showing the duration of our marriage
+// Duration (ms) of animation when changing to showing the duration of our marriage
 // (or changing this message).
-#define MARRIAGE_DURATION_TWEEN_FRAMES 500
+#define MARRIAGE_DURATION_TWEEN_MSEC 500
 
 // Time (ms) between parts of the description of the time we've been married
 #define MARRIAGE_DURATION_PAUSE_MSEC 3000
 
-// Frames for animation when changing to showing the unicom sync status
-#define UNICOM_START_TWEEN_FRAMES 500
+// Duration (ms) of animation when changing to showing the unicom sync status
+#define UNICOM_START_TWEEN_MSEC 500
 
 // Period (ms) of blinking pattern during unisync lock phase
 #define UNICOM_LOCKED_BLINK_PHASE_MSEC 300
@@ -103,20 +143,20 @@
 // Number of frames to to display the automata
 #define AUTOMATA_NUM_FRAMES (10000 / (AUTOMATA_FRAME_MSEC))
 
-// Frames for animation into the automata
-#define AUTOMATA_ENTRY_TWEEN_FRAMES 500
+// Duration (ms) of animation into the automata
+#define AUTOMATA_ENTRY_TWEEN_MSEC 500
 
-// Frames for animation into the automata
-#define AUTOMATA_TWEEN_FRAMES 100
+// Duration (ms) of animation into the automata
+#define AUTOMATA_TWEEN_MSEC 100
 
 // Time (ms) between frames of the I love cube message
 #define I_LOVE_CUBE_FRAME_MSEC 1000
 
-// Frames for animation between frames of the I love cube message
-#define I_LOVE_CUBE_TWEEN_FRAMES 500
+// Duration (ms) of animation between frames of the I love cube message
+#define I_LOVE_CUBE_TWEEN_MSEC 500
 
-// Frames for tweens in smiling time
-#define SMILING_TIME_TWEEN_FRAMES 200
+// Duration (ms) of tweens in smiling time
+#define SMILING_TIME_TWEEN_MSEC 200
 
 // Time (ms) to display "eeek" before smiling time
 #define SMILING_TIME_EEEK_MSEC 2000
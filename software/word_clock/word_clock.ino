@@ -17,9 +17,17 @@
 #include <SPI.h>
 
 #include "UnicomReceiver.h"
+#include "ldr_sampler.h"
+#include "unicom_frame.h"
+#include "tz.h"
 #include "display.h"
+#include "grey.h"
 #include "word_clock.h"
+#include "frame.h"
+#include "frame_sched.h"
+#include "strbuf.h"
 #include "words.h"
+#include "time_mask.h"
 #include "tween.h"
 #include "automata.h"
 #include "text.h"
@@ -31,21 +39,32 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 // Pair of frame buffers to contain current time and previous time
-char buf_a[HEIGHT * WIDTH];
-char buf_b[HEIGHT * WIDTH];
+frame_t buf_a;
+frame_t buf_b;
 
 // Current and previous frame buffers
-char *prev_buf = buf_a;
-char *cur_buf  = buf_b;
+frame_t *prev_buf = &buf_a;
+frame_t *cur_buf  = &buf_b;
+
+// The transition between the previous and current frame buffers and the
+// compositor which produces what is displayed from it.
+tween_t tween;
+tween_compositor_t compositor;
+
+// Scrolling messages are shown by a second tween on top of the first so that
+// they can begin while the previous frame is still fading out. The message's
+// frame is also its mask: only the lit text covers what lies beneath.
+frame_t text_buf;
+tween_t text_tween;
 
 // Switch the buffer in use
 void flip() {
-	if (prev_buf == buf_a) {
-		prev_buf = buf_b;
-		cur_buf  = buf_a;
+	if (prev_buf == &buf_a) {
+		prev_buf = &buf_b;
+		cur_buf  = &buf_a;
 	} else {
-		prev_buf = buf_a;
-		cur_buf  = buf_b;
+		prev_buf = &buf_a;
+		cur_buf  = &buf_b;
 	}
 }
 
@@ -58,25 +77,115 @@ void flip() {
 // Are we currently updating via unicom?
 bool unicom_updating = false;
 
-// Proportion of bits received successfully (0 - 1 inclusive).
+// Progress through the frame currently being received: the number of bits
+// received so far out of the total expected.
 int unicom_bits_arrived;
+int unicom_num_bits;
+
+// Number of intact and corrupt frames received since unicom locked on
+int unicom_frames_ok;
+int unicom_frames_bad;
 
-const int unicom_num_bits = 32;
+// The timezone rules used to convert the RTC's time (UTC) into the local time
+// displayed. Received via unicom and kept in EEPROM.
+tz_t unicom_tz;
+
+// A custom message of the day (empty if none)
+char unicom_motd[UNICOM_FRAME_MAX_PAYLOAD + 1] = "";
 
 UnicomReceiver unicom(LDR_PIN);
 
 /**
- * Function which uses Unicom to update the current time. This should be called
- * frequently.
+ * The local time.
+ */
+time_t local_now(void) {
+	return tz_local_time(&unicom_tz, now());
+}
+
+/**
+ * Act on a frame received via unicom.
+ *
+ * @param frame_started The time (millis()) at which the frame started to
+ *                      arrive.
+ */
+void unicom_handle_frame(const unicom_frame_decoder_t *dec, unsigned long frame_started) {
+	switch (dec->type) {
+		case UNICOM_FRAME_TIME:
+			if (dec->length == 4) {
+				// Compensate for time spent transmitting
+				time_t received_time = unicom_frame_u32(dec->payload);
+				received_time += (500ul + millis() - frame_started) / 1000ul;
+				RTC.set(received_time);
+				setTime(received_time);
+				Serial.println(F("INFO: Successfuly updated clock using unicom."));
+				return;
+			}
+			break;
+		
+		case UNICOM_FRAME_TZ:
+			if (dec->length == 10) {
+				tz_t tz;
+				tz.std_offset       = unicom_frame_s16(dec->payload + 0);
+				tz.dst_offset       = unicom_frame_s16(dec->payload + 2);
+				tz.dst_start.month  = dec->payload[4];
+				tz.dst_start.sunday = dec->payload[5];
+				tz.dst_start.hour   = dec->payload[6];
+				tz.dst_end.month    = dec->payload[7];
+				tz.dst_end.sunday   = dec->payload[8];
+				tz.dst_end.hour     = dec->payload[9];
+				
+				// Keep the current rules rather than adopt nonsense (which would
+				// also be rejected when loaded on the next reset)
+				if (!tz_valid(&tz)) {
+					Serial.println(F("WARNING: Ignored unicom timezone with invalid DST rules."));
+					return;
+				}
+				
+				unicom_tz = tz;
+				tz_save(&unicom_tz, TZ_EEPROM_ADDR);
+				Serial.println(F("INFO: Timezone set using unicom."));
+				return;
+			}
+			break;
+		
+		case UNICOM_FRAME_MOTD:
+			memcpy(unicom_motd, dec->payload, dec->length);
+			unicom_motd[dec->length] = '\0';
+			Serial.println(F("INFO: Message of the day set using unicom."));
+			return;
+		
+		case UNICOM_FRAME_CONFIG:
+			// No configuration settings are currently defined
+			Serial.println(F("INFO: Ignored unicom config."));
+			return;
+	}
+	
+	Serial.print(F("ERROR: Unicom frame with unexpected type/length: "));
+	Serial.print((int)dec->type);
+	Serial.print(F("/"));
+	Serial.println((int)dec->length);
+}
+
+/**
+ * Function which uses Unicom to update the current time (and other settings).
+ * This should be called frequently.
  */
 void unicom_loop() {
 	// Step the Unicom state machine
 	unicom.refresh();
 	
-	// Accumulate incoming time data
-	static size_t bytes_received;
-	static unsigned long received_time;
-	static unsigned long receive_started;
+	// Samples are lost if the main loop falls too far behind the LDR sampler
+	static unsigned long dropped = 0ul;
+	unsigned long now_dropped = ldr_sampler_dropped();
+	if (now_dropped != dropped) {
+		Serial.print(F("WARNING: LDR samples dropped: "));
+		Serial.println(now_dropped - dropped);
+		dropped = now_dropped;
+	}
+	
+	// Frames being decoded from the incoming data
+	static unicom_frame_decoder_t decoder;
+	static unsigned long frame_started;
 	
 	UnicomReceiver::state_t state = unicom.getState();
 	switch (state) {
@@ -90,37 +199,41 @@ void unicom_loop() {
 			// We've got a clock signal, data will arrive shortly
 			unicom_updating = true;
 			unicom_bits_arrived = 0;
-			
-			bytes_received = 0;
-			received_time = 0ul;
-			receive_started = millis();
+			unicom_num_bits = UNICOM_FRAME_OVERHEAD * 8;
+			unicom_frames_ok = 0;
+			unicom_frames_bad = 0;
+			unicom_frame_init(&decoder);
 			break;
 		
 		case UnicomReceiver::STATE_RECEIVING:
 			char c;
-			if (unicom.getByte(&c)) {
-				bytes_received++;
-				
-				// Accumulate first word of data (the time)
-				if (bytes_received <= 4) {
-					received_time |= ((unsigned long)c & 0xFFul) << ((bytes_received-1)*8);
-				}
+			while (unicom.getByte(&c)) {
+				if (!unicom_frame_in_progress(&decoder))
+					frame_started = millis();
 				
-				// Once the time has arrived, update the RTC
-				if (bytes_received == 4) {
-					// Compensate for time spent transmitting
-					received_time += (500ul + millis() - receive_started) / 1000ul;
-					RTC.set(received_time);
-					setTime(received_time);
-					Serial.println(F("INFO: Successfuly updated clock using unicom."));
-					unicom_updating = false;
+				switch (unicom_frame_push(&decoder, c)) {
+					case UNICOM_FRAME_PENDING:
+						break;
+					
+					case UNICOM_FRAME_OK:
+						unicom_frames_ok++;
+						unicom_handle_frame(&decoder, frame_started);
+						break;
+					
+					case UNICOM_FRAME_ERROR:
+						unicom_frames_bad++;
+						Serial.println(F("ERROR: Corrupt unicom frame discarded."));
+						break;
 				}
 			}
 			
-			// Update the progress indicator
-			unicom_bits_arrived = (bytes_received*8) + unicom.getBitsReceived();
-			if (unicom_bits_arrived > unicom_num_bits)
-				unicom_bits_arrived = unicom_num_bits;
+			// Update the progress indicator (which is left showing the last frame
+			// while waiting for the next)
+			if (unicom_frame_in_progress(&decoder)) {
+				unicom_bits_arrived = (unicom_frame_bytes_received(&decoder) * 8)
+				                    + unicom.getBitsReceived();
+				unicom_num_bits = unicom_frame_bytes_expected(&decoder) * 8;
+			}
 			
 			break;
 	}
@@ -177,6 +290,7 @@ void setup() {
 	
 	// Setup display drivers
 	display_begin();
+	grey_begin();
 	
 	// Setup realtime clock
 	setSyncProvider(RTC.get);
@@ -194,13 +308,22 @@ void setup() {
 	pinMode(LDR_N_PIN, OUTPUT); digitalWrite(LDR_N_PIN, LOW);
 	
 	// Initially clear the display buffers
-	for (int i = 0; i < WIDTH*HEIGHT; i++) {
-		buf_a[i] = 0;
-		buf_b[i] = 0;
-	}
+	frame_clear(&buf_a);
+	frame_clear(&buf_b);
+	tween_start(&tween, NULL, cur_buf, TWEEN_CUT, 0);
+	tween_compositor_init(&compositor);
+	tween_compositor_add(&compositor, &tween);
 	
-	// Seed the PRNG
+	// Seed the PRNG (before the LDR is taken over by unicom)
 	randomSeed(analogRead(LDR_PIN));
+	
+	// Start sampling the LDR for unicom
+	if (!tz_load(&unicom_tz, TZ_EEPROM_ADDR))
+		tz_init(&unicom_tz);
+	unicom.begin(UNICOM_SAMPLE_PERIOD_USEC);
+	
+	// Start rendering frames
+	frame_sched_begin(FRAME_PERIOD_USEC);
 }
 
 
@@ -235,11 +358,30 @@ typedef enum {
 } state_t;
 
 
+/**
+ * Get the (PROGMEM) English ordinal suffix for a number (e.g. "st" for 21).
+ */
+const char *ordinal_suffix(int number) {
+	if ((number / 10) % 10 == 1)
+		return PSTR("th");
+	switch (number % 10) {
+		case 1:  return PSTR("st");
+		case 2:  return PSTR("nd");
+		case 3:  return PSTR("rd");
+		default: return PSTR("th");
+	}
+}
+
 
 void loop() {
+	// Process the LDR samples taken in the background by the unicom receiver
 	unicom_loop();
 	shake_detect_loop();
 	
+	// Everything else happens once per frame
+	if (!frame_sched_due())
+		return;
+	
 	// Current state
 	static state_t state = STATE_RESET;
 	
@@ -247,9 +389,6 @@ void loop() {
 	static int last_minute;
 	static int last_hour;
 	
-	// Is a tween currently running?
-	static bool tween_running = false;
-	
 	// For the implementation of timers: the time when the timer was started.
 	static unsigned long last_time;
 	
@@ -286,7 +425,8 @@ void loop() {
 	static int smiling_time_last_day = 0;
 	
 	// General purpose string-constructing buffer
-	static char str[100];
+	static char str_buf[100];
+	static strbuf_t str;
 	
 	// Global state override: force the state machine to show unicom state during
 	// updates
@@ -302,6 +442,8 @@ void loop() {
 			
 			default:
 				// Enter unicom state while not already showing a unicom message
+				// (abandoning any scrolling message)
+				tween_compositor_remove(&compositor, &text_tween);
 				state = STATE_UNICOM;
 				break;
 		}
@@ -320,7 +462,7 @@ void loop() {
 			Serial.println(F("INFO: UI state machine reset"));
 			flip();
 			words_set_mask(cur_buf, "for cube *"); // '*' is a heart
-			tween_start(prev_buf, cur_buf, TWEEN_FADE_FROM_BLACK, RESET_MESSAGE_TWEEN_FRAMES);
+			tween_start(&tween, prev_buf, cur_buf, TWEEN_FADE_FROM_BLACK, RESET_MESSAGE_TWEEN_MSEC);
 			state = STATE_RESET_MESSAGE;
 			last_time = millis();
 			break;
@@ -343,31 +485,28 @@ void loop() {
 		case STATE_CLOCK_UPDATE:
 			{
 				// Update the time, if it has changed (or just entering the clock state)
-				time_t t = now();
+				time_t t = local_now();
 				if (state == STATE_CLOCK || hour(t) != last_hour || minute(t) != last_minute) {
 					last_minute = minute(t);
 					last_hour = hour(t);
 					
-					// Render the time into the current buffer
-					strcpy(str, "it is ");
-					words_append_time(str, hour(t), minute(t));
-					
-					// Start animating a transition
+					// Render the time into the current buffer and start animating a
+					// transition
 					flip();
-					words_set_mask(cur_buf, str);
+					time_mask(cur_buf, hour(t), minute(t));
 					if (state == STATE_CLOCK)
-						tween_start(prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, CLOCK_TWEEN_FRAMES);
+						tween_start(&tween, prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, CLOCK_TWEEN_MSEC);
 					else
-						tween_start(prev_buf, cur_buf, TWEEN_FADE, CLOCK_UPDATE_TWEEN_FRAMES);
+						tween_start(&tween, prev_buf, cur_buf, TWEEN_FADE, CLOCK_UPDATE_TWEEN_MSEC);
 					
 					state = STATE_CLOCK_UPDATE;
-				} else if (!tween_running && (  smiling_time_last_day != day(t)
+				} else if (!tween_running(&tween) && (  smiling_time_last_day != day(t)
 				                             && hour(t) >= smiling_time_hour
 				                             && minute(t) >= smiling_time_minute
 				                             )) {
 					// Show smiling time at the designated time
 					state = STATE_SMILING_TIME;
-				} else if (!tween_running && (  (motd_hour != hour(t) && motd_hour != ((hour(t) + 1)%24))
+				} else if (!tween_running(&tween) && (  (motd_hour != hour(t) && motd_hour != ((hour(t) + 1)%24))
 				                             || (hour(t) == motd_hour && minute(t) >= motd_minute)
 				                             )) {
 					// Show the message of the day at a random point each hour.
@@ -392,22 +531,30 @@ void loop() {
 		//   state = STATE_SCROLL_MESSAGE;
 		////////////////////////////////////////////////////////////////////////////
 		case STATE_SCROLL_MESSAGE:
-			// Start displaying a scrolling message
+			// Start displaying a scrolling message over the previous frame as it
+			// fades out
 			flip();
-			for (int i = 0; i < WIDTH*HEIGHT; i++)
-				cur_buf[i] = 0;
-			tween_start(prev_buf, cur_buf, TWEEN_FADE_TO_BLACK, SCROLL_MESSAGE_TWEEN_FRAMES);
+			frame_clear(cur_buf);
+			tween_start(&tween, prev_buf, cur_buf, TWEEN_FADE_TO_BLACK, SCROLL_MESSAGE_TWEEN_MSEC);
+			frame_clear(&text_buf);
+			tween_start(&text_tween, NULL, &text_buf, TWEEN_CUT, 0);
+			tween_set_mask(&text_tween, &text_buf);
+			tween_compositor_remove(&compositor, &text_tween);
+			tween_compositor_add(&compositor, &text_tween);
 			state = STATE_SCROLL_MESSAGE_UPDATE;
 			last_time = millis();
 			break;
 		
 		case STATE_SCROLL_MESSAGE_UPDATE:
 			// Proceed through the scrolling message
-			if (!tween_running && millis() - last_time >= SCROLLING_MESSAGE_FRAME_MSEC) {
-				if (text_next(cur_buf))
-					tween_start(prev_buf, cur_buf, TWEEN_CUT, 1);
-				else
+			if (millis() - last_time >= SCROLLING_MESSAGE_FRAME_MSEC) {
+				if (text_next(&text_buf)) {
+					tween_start(&text_tween, NULL, &text_buf, TWEEN_CUT, 0);
+					tween_set_mask(&text_tween, &text_buf);
+				} else {
+					tween_compositor_remove(&compositor, &text_tween);
 					state = post_scrolling_message_state;
+				}
 				
 				last_time = millis();
 			}
@@ -427,7 +574,7 @@ void loop() {
 					// Re-wind time such that it appears our aniversary happened on the first
 					// of the month to allow easy getting of the number of months from the
 					// time library.
-					time_t t = now() - (24ul*60ul*60ul*(unsigned long)(ANIVERSARY_DAY - 1));
+					time_t t = local_now() - (24ul*60ul*60ul*(unsigned long)(ANIVERSARY_DAY - 1));
 					aniversary_years = year(t) - ANIVERSARY_YEAR;
 					aniversary_months = month(t) - ANIVERSARY_MONTH;
 					aniversary_days = day(t) - 1;
@@ -441,7 +588,8 @@ void loop() {
 					last_time = millis() - MARRIAGE_DURATION_PAUSE_MSEC;
 					
 					// First message always prefixed
-					strcpy(str, "cubethan for ");
+					strbuf_init(&str, str_buf, sizeof(str_buf));
+					strbuf_append_P(&str, PSTR("cubethan for "));
 				} else {
 					// Work out whether to prefix the current unit
 					int units_left = (aniversary_years >= 1)
@@ -449,41 +597,40 @@ void loop() {
 					               + (aniversary_weeks >= 1)
 					               + (aniversary_days >= 1)
 					               ;
+					strbuf_init(&str, str_buf, sizeof(str_buf));
 					if (units_left == 1)
-						strcpy(str, "and ");
-					else
-						strcpy(str, "");
+						strbuf_append_P(&str, PSTR("and "));
 				}
 				
 				// Show next unit after a pause
 				if (millis() - last_time >= MARRIAGE_DURATION_PAUSE_MSEC) {
 					if (aniversary_years > 19) {
-						words_append_number(str, aniversary_years / 10);
-						words_append(str, " decades");
+						words_append_number(&str, aniversary_years / 10);
+						strbuf_append_P(&str, PSTR(" decades"));
 						aniversary_years %= 10;
 						state = STATE_MARRIAGE_DURATION_UPDATE;
 					} else if (aniversary_years >= 1) {
-						words_append_number(str, aniversary_years);
-						words_append(str, " year");
-						if (aniversary_years > 1) words_append(str, "s");
+						words_append_number(&str, aniversary_years);
+						strbuf_append_P(&str, PSTR(" year"));
+						if (aniversary_years > 1) strbuf_append_P(&str, PSTR("s"));
 						aniversary_years = 0;
 						state = STATE_MARRIAGE_DURATION_UPDATE;
 					} else if (aniversary_months >= 1) {
-						words_append_number(str, aniversary_months);
-						words_append(str, " month");
-						if (aniversary_months > 1) words_append(str, "s");
+						words_append_number(&str, aniversary_months);
+						strbuf_append_P(&str, PSTR(" month"));
+						if (aniversary_months > 1) strbuf_append_P(&str, PSTR("s"));
 						aniversary_months = 0;
 						state = STATE_MARRIAGE_DURATION_UPDATE;
 					} else if (aniversary_weeks >= 1) {
-						words_append_number(str, aniversary_weeks);
-						words_append(str, " week");
-						if (aniversary_weeks > 1) words_append(str, "s");
+						words_append_number(&str, aniversary_weeks);
+						strbuf_append_P(&str, PSTR(" week"));
+						if (aniversary_weeks > 1) strbuf_append_P(&str, PSTR("s"));
 						aniversary_weeks = 0;
 						state = STATE_MARRIAGE_DURATION_UPDATE;
 					} else if (aniversary_days >= 1) {
-						words_append_number(str, aniversary_days);
-						words_append(str, " day");
-						if (aniversary_days > 1) words_append(str, "s");
+						words_append_number(&str, aniversary_days);
+						strbuf_append_P(&str, PSTR(" day"));
+						if (aniversary_days > 1) strbuf_append_P(&str, PSTR("s"));
 						aniversary_days = 0;
 						state = STATE_MARRIAGE_DURATION_UPDATE;
 					} else {
@@ -494,8 +641,8 @@ void loop() {
 					// Display the units if any remained.
 					if (state == STATE_MARRIAGE_DURATION_UPDATE) {
 						flip();
-						words_set_mask(cur_buf, str);
-						tween_start(prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, MARRIAGE_DURATION_TWEEN_FRAMES);
+						words_set_mask(cur_buf, str.str);
+						tween_start(&tween, prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, MARRIAGE_DURATION_TWEEN_MSEC);
 						last_time = millis();
 					}
 				}
@@ -506,88 +653,96 @@ void loop() {
 		// Show the message of the day (enter via STATE_MOTD)
 		//
 		// The message of the day may be an aniversary, birthday or holiday
-		// greeting. If not a 'special' date the duration of our marriage will be
-		// displayed. Entering this state will cause the next MOTD to be shown at a
-		// random point in the following hour.
+		// greeting. If not a 'special' date, any custom message sent via unicom
+		// followed by the duration of our marriage will be displayed. Entering
+		// this state will cause the next MOTD to be shown at a random point in the
+		// following hour.
 		////////////////////////////////////////////////////////////////////////////
 		case STATE_MOTD:
-			// Schedule the next message of the day...
-			if (day() == NEW_YEAR_EVE_DAY && month() == NEW_YEAR_EVE_MONTH) {
-				// Make sure it happens just after midnight on new-year's eve...
-				motd_hour = 0;
-				motd_minute = 0;
-			} else {
-				// Otherwise, pick randomly in the next hour
-				motd_hour = (hour()+1) % 24;
-				motd_minute = random(0,60);
-			}
-			
-			// Enter an appropriate state for the day
-			if (day() == ANIVERSARY_DAY && month() == ANIVERSARY_MONTH) {
-				// Aniversary today!
-				int years = year() - ANIVERSARY_YEAR;
-				sprintf(str
-				       , "Happy %d%s Anniversary!"
-				       , years
-				       ,   ((years%10 == 1) && (years/10 != 1)) ? "st"
-				         : ((years%10 == 2) && (years/10 != 1)) ? "nd"
-				         : ((years%10 == 3) && (years/10 != 1)) ? "rd"
-				         : "th"
-				       );
-				text_start(str);
-				post_scrolling_message_state = STATE_MARRIAGE_DURATION;
-				state = STATE_SCROLL_MESSAGE;
-			} else if (day() == MET_DAY && month() == MET_MONTH) {
-				// We met today!
-				int years = year() - MET_YEAR;
-				sprintf(str, "It's %d years since we met!", years);
-				text_start(str);
-				post_scrolling_message_state = STATE_MARRIAGE_DURATION;
-				state = STATE_SCROLL_MESSAGE;
-			} else if (day() == CUBE_BIRTHDAY_DAY && month() == CUBE_BIRTHDAY_MONTH) {
-				// Cube's birthday
-				int age = year() - CUBE_BIRTHDAY_YEAR;
-				sprintf(str
-				       , "Happy %d%s Birthday, Cube!"
-				       , age
-				       ,   ((age%10 == 1) && (age/10 != 1)) ? "st"
-				         : ((age%10 == 2) && (age/10 != 1)) ? "nd"
-				         : ((age%10 == 3) && (age/10 != 1)) ? "rd"
-				         : "th"
-				       );
-				text_start(str);
-				post_scrolling_message_state = STATE_MARRIAGE_DURATION;
-				state = STATE_SCROLL_MESSAGE;
-			} else if (day() == THAN_BIRTHDAY_DAY && month() == THAN_BIRTHDAY_MONTH) {
-				// Than's birthday
-				int age = year() - THAN_BIRTHDAY_YEAR;
-				sprintf(str
-				       , "Happy %d%s Birthday, 'than!"
-				       , age
-				       ,   ((age%10 == 1) && (age/10 != 1)) ? "st"
-				         : ((age%10 == 2) && (age/10 != 1)) ? "nd"
-				         : ((age%10 == 3) && (age/10 != 1)) ? "rd"
-				         : "th"
-				       );
-				text_start(str);
-				post_scrolling_message_state = STATE_MARRIAGE_DURATION;
-				state = STATE_SCROLL_MESSAGE;
-			} else if (day() == CHRISTMAS_DAY && month() == CHRISTMAS_MONTH) {
-				// Jesus's birthday
-				strcpy(str, "Merry Christmas!");
-				text_start(str);
-				post_scrolling_message_state = STATE_MARRIAGE_DURATION;
-				state = STATE_SCROLL_MESSAGE;
-			} else if (day() == NEW_YEAR_DAY && month() == NEW_YEAR_MONTH) {
-				// New year's day
-				sprintf(str, "Happy %d!", year());
-				text_start(str);
-				post_scrolling_message_state = STATE_MARRIAGE_DURATION;
-				state = STATE_SCROLL_MESSAGE;
-			} else {
-				// Just another day with my cubewife! Just say how long we've been
-				// together.
-				state = STATE_MARRIAGE_DURATION;
+			{
+				time_t t = local_now();
+				
+				// Schedule the next message of the day...
+				if (day(t) == NEW_YEAR_EVE_DAY && month(t) == NEW_YEAR_EVE_MONTH) {
+					// Make sure it happens just after midnight on new-year's eve...
+					motd_hour = 0;
+					motd_minute = 0;
+				} else {
+					// Otherwise, pick randomly in the next hour
+					motd_hour = (hour(t)+1) % 24;
+					motd_minute = random(0,60);
+				}
+				
+				// Enter an appropriate state for the day
+				if (day(t) == ANIVERSARY_DAY && month(t) == ANIVERSARY_MONTH) {
+					// Aniversary today!
+					int years = year(t) - ANIVERSARY_YEAR;
+					strbuf_init(&str, str_buf, sizeof(str_buf));
+					strbuf_append_P(&str, PSTR("Happy "));
+					strbuf_append_int(&str, years);
+					strbuf_append_P(&str, ordinal_suffix(years));
+					strbuf_append_P(&str, PSTR(" Anniversary!"));
+					text_start(str.str);
+					post_scrolling_message_state = STATE_MARRIAGE_DURATION;
+					state = STATE_SCROLL_MESSAGE;
+				} else if (day(t) == MET_DAY && month(t) == MET_MONTH) {
+					// We met today!
+					int years = year(t) - MET_YEAR;
+					strbuf_init(&str, str_buf, sizeof(str_buf));
+					strbuf_append_P(&str, PSTR("It's "));
+					strbuf_append_int(&str, years);
+					strbuf_append_P(&str, PSTR(" years since we met!"));
+					text_start(str.str);
+					post_scrolling_message_state = STATE_MARRIAGE_DURATION;
+					state = STATE_SCROLL_MESSAGE;
+				} else if (day(t) == CUBE_BIRTHDAY_DAY && month(t) == CUBE_BIRTHDAY_MONTH) {
+					// Cube's birthday
+					int age = year(t) - CUBE_BIRTHDAY_YEAR;
+					strbuf_init(&str, str_buf, sizeof(str_buf));
+					strbuf_append_P(&str, PSTR("Happy "));
+					strbuf_append_int(&str, age);
+					strbuf_append_P(&str, ordinal_suffix(age));
+					strbuf_append_P(&str, PSTR(" Birthday, Cube!"));
+					text_start(str.str);
+					post_scrolling_message_state = STATE_MARRIAGE_DURATION;
+					state = STATE_SCROLL_MESSAGE;
+				} else if (day(t) == THAN_BIRTHDAY_DAY && month(t) == THAN_BIRTHDAY_MONTH) {
+					// Than's birthday
+					int age = year(t) - THAN_BIRTHDAY_YEAR;
+					strbuf_init(&str, str_buf, sizeof(str_buf));
+					strbuf_append_P(&str, PSTR("Happy "));
+					strbuf_append_int(&str, age);
+					strbuf_append_P(&str, ordinal_suffix(age));
+					strbuf_append_P(&str, PSTR(" Birthday, 'than!"));
+					text_start(str.str);
+					post_scrolling_message_state = STATE_MARRIAGE_DURATION;
+					state = STATE_SCROLL_MESSAGE;
+				} else if (day(t) == CHRISTMAS_DAY && month(t) == CHRISTMAS_MONTH) {
+					// Jesus's birthday
+					strbuf_init(&str, str_buf, sizeof(str_buf));
+					strbuf_append_P(&str, PSTR("Merry Christmas!"));
+					text_start(str.str);
+					post_scrolling_message_state = STATE_MARRIAGE_DURATION;
+					state = STATE_SCROLL_MESSAGE;
+				} else if (day(t) == NEW_YEAR_DAY && month(t) == NEW_YEAR_MONTH) {
+					// New year's day
+					strbuf_init(&str, str_buf, sizeof(str_buf));
+					strbuf_append_P(&str, PSTR("Happy "));
+					strbuf_append_int(&str, year(t));
+					strbuf_append_char(&str, '!');
+					text_start(str.str);
+					post_scrolling_message_state = STATE_MARRIAGE_DURATION;
+					state = STATE_SCROLL_MESSAGE;
+				} else if (unicom_motd[0] != '\0') {
+					// A custom message has been sent via unicom
+					text_start(unicom_motd);
+					post_scrolling_message_state = STATE_MARRIAGE_DURATION;
+					state = STATE_SCROLL_MESSAGE;
+				} else {
+					// Just another day with my cubewife! Just say how long we've been
+					// together.
+					state = STATE_MARRIAGE_DURATION;
+				}
 			}
 			break;
 		
@@ -605,7 +760,7 @@ void loop() {
 			flip();
 			face(cur_buf, 0, false);
 			last_time = millis();
-			tween_start(prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, UNICOM_START_TWEEN_FRAMES);
+			tween_start(&tween, prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, UNICOM_START_TWEEN_MSEC);
 			state = STATE_UNICOM_LOCKED;
 			break;
 		
@@ -619,10 +774,10 @@ void loop() {
 				state = STATE_UNICOM_TRANSFERRING;
 			} else {
 				// Blink the eyes while locked
-				if (!tween_running && millis() - last_time >= UNICOM_LOCKED_BLINK_PHASE_MSEC) {
+				if (!tween_running(&tween) && millis() - last_time >= UNICOM_LOCKED_BLINK_PHASE_MSEC) {
 					last_time = millis();
 					face(cur_buf, 0, (animation_frame++)&1);
-					tween_start(prev_buf, cur_buf, TWEEN_CUT, 1);
+					tween_start(&tween, prev_buf, cur_buf, TWEEN_CUT, 0);
 				}
 			}
 			break;
@@ -636,15 +791,16 @@ void loop() {
 				else
 					animation_frame = FACE_MAX;
 				face(cur_buf, animation_frame, false);
-				tween_start(prev_buf, cur_buf, TWEEN_CUT, 1);
+				tween_start(&tween, prev_buf, cur_buf, TWEEN_CUT, 0);
 			} else {
-				if (unicom_bits_arrived >= unicom_num_bits) {
+				// Corrupt frames are fine so long as a good copy arrived too
+				if (unicom_frames_ok > 0) {
 					Serial.println(F("INFO: Unicom data stream arrived successfuly."));
 					state = STATE_UNICOM_OK;
 				} else {
-					Serial.print(F("ERROR: Unicom data stream failed after "));
-					Serial.print(unicom_bits_arrived);
-					Serial.println(F(" bits."));
+					Serial.print(F("ERROR: Unicom data stream failed with "));
+					Serial.print(unicom_frames_bad);
+					Serial.println(F(" corrupt frames."));
 					state = STATE_UNICOM_ERROR;
 				}
 				
@@ -667,7 +823,7 @@ void loop() {
 					if (animation_frame > FACE_MAX)
 						animation_frame = FACE_MAX;
 					face(cur_buf, animation_frame, false);
-					tween_start(prev_buf, cur_buf, TWEEN_CUT, 1);
+					tween_start(&tween, prev_buf, cur_buf, TWEEN_CUT, 0);
 					animation_frame--;
 					last_time = millis();
 				}
@@ -714,7 +870,7 @@ void loop() {
 						case 1: words_set_mask(cur_buf, "*");    break; // Heart
 						case 2: words_set_mask(cur_buf, "cube"); break;
 					}
-					tween_start(prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, I_LOVE_CUBE_TWEEN_FRAMES);
+					tween_start(&tween, prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, I_LOVE_CUBE_TWEEN_MSEC);
 					last_time = millis();
 					animation_frame++;
 				} else {
@@ -745,7 +901,7 @@ void loop() {
 						words_set_mask(cur_buf, "*"); // Heart in the middle of the array
 					else
 						automata_xor(cur_buf, prev_buf);
-					tween_start(prev_buf, cur_buf, TWEEN_FADE, AUTOMATA_TWEEN_FRAMES);
+					tween_start(&tween, prev_buf, cur_buf, TWEEN_FADE, AUTOMATA_TWEEN_MSEC);
 					last_time = millis();
 				} else {
 					state = STATE_CLOCK;
@@ -764,12 +920,12 @@ void loop() {
 			// Start displaying "eeek"
 			flip();
 			words_set_mask(cur_buf, "ee e e e e e e k");
-			tween_start(prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, SMILING_TIME_TWEEN_FRAMES);
+			tween_start(&tween, prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, SMILING_TIME_TWEEN_MSEC);
 			last_time = millis();
 			state = STATE_SMILING_TIME_EEEK;
 			
 			// Schedule the next smiling time randomly tomorrow
-			smiling_time_last_day = day();
+			smiling_time_last_day = day(local_now());
 			smiling_time_hour     = random( SMILING_TIME_CANDIDATES_START
 			                              , SMILING_TIME_CANDIDATES_END+1
 			                              );
@@ -782,24 +938,25 @@ void loop() {
 				flip();
 				animation_frame = 0;
 				face(cur_buf, animation_frame, false);
-				tween_start(prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, SMILING_TIME_TWEEN_FRAMES);
+				tween_start(&tween, prev_buf, cur_buf, TWEEN_FADE_THROUGH_BLACK, SMILING_TIME_TWEEN_MSEC);
 				state = STATE_SMILING_TIME_FACE;
 				last_time = millis();
 			}
 			break;
 		
 		case STATE_SMILING_TIME_FACE:
-			if (!tween_running && millis() - last_time >= SMILING_TIME_FRAME_MSEC) {
+			if (!tween_running(&tween) && millis() - last_time >= SMILING_TIME_FRAME_MSEC) {
 				if (animation_frame < FACE_MAX) {
 					// Get more and more excited
 					animation_frame++;
 					face(cur_buf, animation_frame, false);
-					tween_start(prev_buf, cur_buf, TWEEN_CUT, 1);
+					tween_start(&tween, prev_buf, cur_buf, TWEEN_CUT, 0);
 					last_time = millis();
 				} else {
 					// And eventually show a scrolling message
-					strcpy(str, "Smiling Time!");
-					text_start(str);
+					strbuf_init(&str, str_buf, sizeof(str_buf));
+					strbuf_append_P(&str, PSTR("Smiling Time!"));
+					text_start(str.str);
 					post_scrolling_message_state = STATE_CLOCK;
 					state = STATE_SCROLL_MESSAGE;
 				}
@@ -813,12 +970,19 @@ void loop() {
 			break;
 	}
 	
-	// Update the display
+	// Update the display. Greyscale frames are shown by the greyscale engine
+	// which must be stopped before sending ordinary frames.
 	int intensity;
-	const char *buf;
-	tween_running = tween_next(&buf, &intensity);
-	if (tween_running) {
-		display_buf(buf, intensity);
+	const frame_t *buf;
+	const grey_frame_t *grey;
+	if (tween_compositor_next(&compositor, &buf, &grey, &intensity)) {
+		if (grey) {
+			grey_show(grey, intensity);
+		} else {
+			grey_stop();
+			display_buf(buf, intensity);
+		}
 	}
 	
+	frame_sched_end();
 }
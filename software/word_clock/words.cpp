@@ -1,44 +1,30 @@
 /**
- * Functions for 
+ * Functions for generating strings and masks for the letter mask.
  */
 
 #include <string.h>
+#include <avr/pgmspace.h>
 
 #include "words.h"
 #include "word_clock.h"
+#include "frame.h"
+#include "strbuf.h"
 
 ////////////////////////////////////////////////////////////////////////////////
 // Character mask
 ////////////////////////////////////////////////////////////////////////////////
 
-#ifdef ARDUINO
-	#include <avr/pgmspace.h>
-	typedef prog_uchar mask_t;
-	#define WORDS_PROGMEM PROGMEM
-	#define GET_MASK_CHAR(x,y) ((char)(pgm_read_byte_near(WORDS + ((y)*WIDTH) + (x))))
-#else
-	typedef char mask_t;
-	#define WORDS_PROGMEM
-	#define GET_MASK_CHAR(x,y) ((char)(WORDS[y*WIDTH + x]))
-#endif
+#include "words_grid.h"
 
-// Lookup from pixel coordinate to character on the display. ('*' is a heart).
-static const mask_t WORDS[HEIGHT*WIDTH] WORDS_PROGMEM = {
-	'f','o','r','i','t','c','u','b','e','t','h','a','n','d','y',
-	'i','s','f','o','r','t','w','e','n','t','y','e','t','w','o',
-	'o','n','e','l','e','v','e','n','i','n','e','t','e','e','n',
-	't','h','r','e','e','i','g','h','t','e','e','n','t','e','n',
-	's','e','v','e','n','t','e','e','n','t','w','e','l','v','e',
-	't','h','i','r','t','e','e','n','q','u','a','r','t','e','r',
-	'f','o','u','r','t','e','e','n','s','i','x','t','e','e','n',
-	'h','a','l','f','i','v','e','*','m','i','n','u','t','e','s',
-	'p','a','s','t','o','f','i','f','t','e','e','n','t','e','n',
-	't','h','r','e','e','l','e','v','e','n','i','n','e','g','o',
-	'o','n','e','i','g','h','t','w','o','t','w','e','l','v','e',
-	'w','e','e','k','s','e','v','e','n','d','a','y','s','i','x',
-	'f','o','u','r','f','i','v','e','d','e','c','a','d','e','s',
-	'y','e','a','r','s','a','m','o','n','t','h','s','p','m','k'
-};
+// An index giving, for each letter slot, the cells in the mask containing that
+// letter in descending order. The cells for slot s are
+// WORDS_INDEX_CELLS[WORDS_INDEX_START[s]] to
+// WORDS_INDEX_CELLS[WORDS_INDEX_START[s+1] - 1]. This table can be regenerated
+// (e.g. after changing the letter mask) using:
+//
+//   cd ../host && make tables
+
+#include "words_index.h"
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -46,105 +32,86 @@ static const mask_t WORDS[HEIGHT*WIDTH] WORDS_PROGMEM = {
 ////////////////////////////////////////////////////////////////////////////////
 
 /**
- * Set every element in the buffer to zero starting immediately following coordinate given and
- * working from right-to-left and bottom-to-top until the top left corner is
- * reached.
+ * Find the right-most placement of a word in the mask which ends before a
+ * given cell.
+ *
+ * @param word The first character of the word.
+ * @param len The number of characters in the word (at least 1).
+ * @param limit The word must end in a cell before this one.
+ * @returns The cell containing the first character of the word or -1 if the
+ *          word cannot be placed.
  */
-static void clear_buffer_after(char *buf, int x, int y) {
-	if (x != 0) {
-		x--;
-	} else {
-		x = WIDTH-1;
-		y--;
-	}
+static int find_word(const char *word, int len, int limit) {
+	// Only the cells containing the word's last letter are candidates for the
+	// end of the word.
+	int slot = WORDS_LETTER_SLOT(word[len-1]);
+	if (slot < 0)
+		return -1;
 	
-	for (; y >= 0; y--) {
-		for (; x >= 0; x--) {
-			buf[y*WIDTH + x] = 0;
-		}
-		x = WIDTH-1;
+	int first = pgm_read_byte_near(WORDS_INDEX_START + slot);
+	int last  = pgm_read_byte_near(WORDS_INDEX_START + slot + 1);
+	for (int i = first; i < last; i++) {
+		int end = pgm_read_byte_near(WORDS_INDEX_CELLS + i);
+		if (end >= limit)
+			continue;
+		
+		// Candidates are in descending order so if the word doesn't fit before
+		// this one, it won't fit before any others.
+		int start = end - (len - 1);
+		if (start < 0)
+			return -1;
+		
+		// Check the remaining letters
+		int matched = len - 1;
+		while (matched > 0 && GET_MASK_CELL(start + matched - 1) == word[matched - 1])
+			matched--;
+		if (matched == 0)
+			return start;
 	}
+	
+	return -1;
 }
 
 
-bool words_set_mask(char *buf, const char *str) {
-	// Cast to multi-dimensional array
+bool words_set_mask(frame_t *buf, const char *str) {
+	// Start from a blank frame (this also ensures the unused bits of each row
+	// are zero).
+	frame_clear(buf);
 	
-	// Last char of current word being placed
-	const char *cur_word = str + strlen(str) - 1;
-	// Next char to be placed
-	const char *cur_char = cur_word;
-	
-	// Scan backwards through the character array and string attempting to place
-	// each word, back-tracking if a word cannot be placed.
-	bool skip_next = false;
-	for (int y = HEIGHT-1; y >= 0; y--) {
-		for (int x = WIDTH-1; x >= 0; x--) {
-			if (skip_next) {
-				skip_next = false;
-				buf[y*WIDTH + x] = 0;
-				continue;
-			}
-			
-			if (GET_MASK_CHAR(x,y) == *cur_char) {
-				// Character found!
-				buf[y*WIDTH + x] = 1;
-				
-				if (cur_char == str) {
-					// The current character was the last
-					clear_buffer_after(buf, x,y);
-					return true;
-				} else {
-					// Not at the beginning yet, move onto next character.
-					cur_char--;
-				}
-				
-				if (*cur_char == ' ') {
-					// Completed the a word, skip at least one character in the mask or
-					// leave a line-break.
-					if (x != 0)
-						skip_next = true;
-					
-					// Advance to the next word
-					if (cur_char != str && *cur_char == ' ')
-						cur_char--;
-					cur_word = cur_char;
-					
-					// Special case: the start of the string was whitespace which we've
-					// now skipped over and thus we can now terminate successfuly.
-					if (cur_char == str) {
-						clear_buffer_after(buf, x,y);
-						return true;
-					}
-				}
-			} else if (cur_char != cur_word) {
-				// The word was not matched after at least one character had matched
-				// succssfully, unwind all characters in the word.
-				if (x+1 < WIDTH) {
-					x++;
-				} else {
-					y++;
-					x=0;
-				}
-				for (; y < HEIGHT; y++) {
-					for (; x < WIDTH; x++) {
-						cur_char++;
-						buf[y*WIDTH + x] = 0;
-						if (cur_char == cur_word)
-							break;
-					}
-					if (cur_char == cur_word)
-						break;
-				}
-			} else {
-				// The first character of the current word was not matched
-				buf[y*WIDTH + x] = 0;
-			}
-		}
+	// Place each word from right-to-left, each as far right as possible and
+	// before the cell given by limit.
+	int limit = HEIGHT*WIDTH;
+	const char *word_end = str + strlen(str);
+	while (word_end > str) {
+		const char *word = word_end;
+		while (word > str && word[-1] != ' ')
+			word--;
+		int len = word_end - word;
+		
+		// Empty words (i.e. trailing or repeated spaces) can't be displayed
+		if (len == 0)
+			return false;
+		
+		int cell = find_word(word, len, limit);
+		if (cell < 0)
+			return false;
+		
+		for (int i = cell; i < cell + len; i++)
+			frame_set(buf, i % WIDTH, i / WIDTH, 1);
+		
+		// The next word must leave at least one unlit character or a line-break
+		if (cell % WIDTH != 0)
+			limit = cell - 1;
+		else
+			limit = cell;
+		
+		// Move past the space before this word
+		word_end = word;
+		if (word_end > str)
+			word_end--;
 	}
 	
-	// If we got here, the whole string wasn't found
-	return false;
+	return true;
 }
 
 
@@ -153,12 +120,7 @@ bool words_set_mask(char *buf, const char *str) {
 ////////////////////////////////////////////////////////////////////////////////
 
 
-void words_append(char *str, const char *appendage) {
-	str = str + strlen(str);
-	strcpy(str, appendage);
-}
-
-void words_append_number(char *str, int number) {
+void words_append_number(strbuf_t *str, int number) {
 	// Fail if out of bounds
 	if (number < 1 or number > 29)
 		return;
@@ -168,43 +130,43 @@ void words_append_number(char *str, int number) {
 	
 	bool has_tens_prefix;
 	switch (tens) {
-		case 2: words_append(str, "twenty"); has_tens_prefix = true; break;
+		case 2: strbuf_append_P(str, PSTR("twenty")); has_tens_prefix = true; break;
 		default: has_tens_prefix = false; break;
 	}
 	
 	if (has_tens_prefix && units != 0)
-		words_append(str, " ");
+		strbuf_append_P(str, PSTR(" "));
 	
 	if (number < 10 || number >= 20) {
 		switch (units) {
 			case 0: break;
-			case 1: words_append(str, "one"); break;
-			case 2: words_append(str, "two"); break;
-			case 3: words_append(str, "three"); break;
-			case 4: words_append(str, "four"); break;
-			case 5: words_append(str, "five"); break;
-			case 6: words_append(str, "six"); break;
-			case 7: words_append(str, "seven"); break;
-			case 8: words_append(str, "eight"); break;
-			case 9: words_append(str, "nine"); break;
+			case 1: strbuf_append_P(str, PSTR("one")); break;
+			case 2: strbuf_append_P(str, PSTR("two")); break;
+			case 3: strbuf_append_P(str, PSTR("three")); break;
+			case 4: strbuf_append_P(str, PSTR("four")); break;
+			case 5: strbuf_append_P(str, PSTR("five")); break;
+			case 6: strbuf_append_P(str, PSTR("six")); break;
+			case 7: strbuf_append_P(str, PSTR("seven")); break;
+			case 8: strbuf_append_P(str, PSTR("eight")); break;
+			case 9: strbuf_append_P(str, PSTR("nine")); break;
 		}
 	} else {
 		switch (number) {
-			case 10: words_append(str, "ten"); break;
-			case 11: words_append(str, "eleven"); break;
-			case 12: words_append(str, "twelve"); break;
-			case 13: words_append(str, "thirteen"); break;
-			case 14: words_append(str, "fourteen"); break;
-			case 15: words_append(str, "fifteen"); break;
-			case 16: words_append(str, "sixteen"); break;
-			case 17: words_append(str, "seventeen"); break;
-			case 18: words_append(str, "eighteen"); break;
-			case 19: words_append(str, "nineteen"); break;
+			case 10: strbuf_append_P(str, PSTR("ten")); break;
+			case 11: strbuf_append_P(str, PSTR("eleven")); break;
+			case 12: strbuf_append_P(str, PSTR("twelve")); break;
+			case 13: strbuf_append_P(str, PSTR("thirteen")); break;
+			case 14: strbuf_append_P(str, PSTR("fourteen")); break;
+			case 15: strbuf_append_P(str, PSTR("fifteen")); break;
+			case 16: strbuf_append_P(str, PSTR("sixteen")); break;
+			case 17: strbuf_append_P(str, PSTR("seventeen")); break;
+			case 18: strbuf_append_P(str, PSTR("eighteen")); break;
+			case 19: strbuf_append_P(str, PSTR("nineteen")); break;
 		}
 	}
 }
 
-void words_append_time(char *str, int hours, int minutes) {
+void words_append_time(strbuf_t *str, int hours, int minutes) {
 	int relative_minutes;
 	int relative_hours;
 	bool past;
@@ -236,26 +198,26 @@ void words_append_time(char *str, int hours, int minutes) {
 		case 11: case 12: case 13: case 14: case 16: case 17: case 18: case 19: case 20:
 		case 21: case 22: case 23: case 24: case 25: case 26: case 27: case 28: case 29:
 			words_append_number(str, relative_minutes);
-			words_append(str, " minute");
+			strbuf_append_P(str, PSTR(" minute"));
 			if (relative_minutes > 1)
-				words_append(str, "s");
+				strbuf_append_P(str, PSTR("s"));
 			break;
 		
 		case 15:
-			words_append(str, "quarter");
+			strbuf_append_P(str, PSTR("quarter"));
 			break;
 		
 		case 30:
-			words_append(str, "half");
+			strbuf_append_P(str, PSTR("half"));
 			break;
 	}
 	
 	// Render past/to
 	if (relative_minutes != 0) {
 		if (past)
-			words_append(str, " past ");
+			strbuf_append_P(str, PSTR(" past "));
 		else
-			words_append(str, " to ");
+			strbuf_append_P(str, PSTR(" to "));
 	}
 	
 	// Render hours
@@ -263,7 +225,7 @@ void words_append_time(char *str, int hours, int minutes) {
 	
 	// Render AM/PM
 	if (am)
-		words_append(str, " am");
+		strbuf_append_P(str, PSTR(" am"));
 	else
-		words_append(str, " pm");
+		strbuf_append_P(str, PSTR(" pm"));
 }
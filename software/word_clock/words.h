@@ -7,6 +7,8 @@
 #define WORDS_H
 
 #include "word_clock.h"
+#include "frame.h"
+#include "strbuf.h"
 
 /**
  * Get the pixel mask required to display a specified string based on the mask
@@ -16,27 +18,21 @@
  * bottom-right to top-left of the mask). This means that when displaying the
  * time, the hours are displayed in consistent locations.
  *
- * @param buf A pointer to a buffer of size [HEIGHT][WIDTH] which will be loaded
- *            with 0 where no character is present and 1 where a character is
- *            present.
+ * @param buf A frame buffer which will be loaded with 0 where no character is
+ *            present and 1 where a character is present.
  *
  * @param str A string to be displayed.
  *
  * @returns True if the string was successfuly displayed or false if the string
  *          could not be rendered using the characters available.
  */
-bool words_set_mask(char *buf, const char *str);
+bool words_set_mask(frame_t *buf, const char *str);
 
 
 /**
- * Append a string onto to another string.
+ * Append a number in the range 1 to 29 inclusive written as words (e.g. "one").
  */
-void words_append(char *str, const char *appendage);
-
-/**
- * Append a number in the range 1 to 39 inclusive written as words (e.g. "one").
- */
-void words_append_number(char *str, int number);
+void words_append_number(strbuf_t *str, int number);
 
 /**
  * Append the time as strings such as "twenty four to seven pm" and "quarter
@@ -45,6 +41,6 @@ void words_append_number(char *str, int number);
  * @param hours Number of hours on 24-hour clock (i.e. 0-23)
  * @param minutes Number of minutes (i.e. 0-59)
  */
-void words_append_time(char *str, int hours, int minutes);
+void words_append_time(strbuf_t *str, int hours, int minutes);
 
 #endif
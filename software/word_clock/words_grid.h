@@ -0,0 +1,48 @@
+/**
+ * The letter mask in front of the display. Cells are numbered in row-major
+ * order, i.e. cell = (y*WIDTH) + x.
+ */
+
+#ifndef WORDS_GRID_H
+#define WORDS_GRID_H
+
+#include "word_clock.h"
+
+#ifdef ARDUINO
+	#include <avr/pgmspace.h>
+	typedef prog_uchar mask_t;
+	#define WORDS_PROGMEM PROGMEM
+	#define GET_MASK_CELL(cell) ((char)(pgm_read_byte_near(WORDS + (cell))))
+#else
+	typedef char mask_t;
+	#define WORDS_PROGMEM
+	#define GET_MASK_CELL(cell) ((char)(WORDS[(cell)]))
+#endif
+
+// Lookup from pixel coordinate to character on the display. ('*' is a heart).
+static const mask_t WORDS[HEIGHT*WIDTH] WORDS_PROGMEM = {
+	'f','o','r','i','t','c','u','b','e','t','h','a','n','d','y',
+	'i','s','f','o','r','t','w','e','n','t','y','e','t','w','o',
+	'o','n','e','l','e','v','e','n','i','n','e','t','e','e','n',
+	't','h','r','e','e','i','g','h','t','e','e','n','t','e','n',
+	's','e','v','e','n','t','e','e','n','t','w','e','l','v','e',
+	't','h','i','r','t','e','e','n','q','u','a','r','t','e','r',
+	'f','o','u','r','t','e','e','n','s','i','x','t','e','e','n',
+	'h','a','l','f','i','v','e','*','m','i','n','u','t','e','s',
+	'p','a','s','t','o','f','i','f','t','e','e','n','t','e','n',
+	't','h','r','e','e','l','e','v','e','n','i','n','e','g','o',
+	'o','n','e','i','g','h','t','w','o','t','w','e','l','v','e',
+	'w','e','e','k','s','e','v','e','n','d','a','y','s','i','x',
+	'f','o','u','r','f','i','v','e','d','e','c','a','d','e','s',
+	'y','e','a','r','s','a','m','o','n','t','h','s','p','m','k'
+};
+
+// Letters which may appear in the mask are indexed by "slot": 'a'-'z' are
+// slots 0-25 and '*' (the heart) is slot 26. Other characters have no slot
+// (-1).
+#define WORDS_NUM_LETTER_SLOTS 27
+#define WORDS_LETTER_SLOT(c) (  ((c) >= 'a' && (c) <= 'z') ? ((c) - 'a') \
+                              : ((c) == '*') ? 26 \
+                              : -1)
+
+#endif
@@ -0,0 +1,61 @@
+/**
+ * Automatically-generated letter mask index.
+ *   gen_words_index
+ */
+PROGMEM prog_uchar WORDS_INDEX_START[28] = {
+	  0, // 'a'
+	  8, // 'b'
+	  9, // 'c'
+	 11, // 'd'
+	 15, // 'e'
+	 63, // 'f'
+	 71, // 'g'
+	 74, // 'h'
+	 82, // 'i'
+	 95, // 'j'
+	 95, // 'k'
+	 97, // 'l'
+	102, // 'm'
+	105, // 'n'
+	126, // 'o'
+	137, // 'p'
+	139, // 'q'
+	140, // 'r'
+	150, // 's'
+	160, // 't'
+	184, // 'u'
+	189, // 'v'
+	197, // 'w'
+	203, // 'x'
+	205, // 'y'
+	209, // 'z'
+	209, // '*'
+	210,
+};
+PROGMEM prog_uchar WORDS_INDEX_CELLS[210] = {
+	200, 197, 191, 175, 121, 106,  85,  11, // 'a'
+	  7, // 'b'
+	190,   5, // 'c'
+	192, 188, 174,  13, // 'd'
+	196, 193, 189, 187, 172, 170, 167, 166, 164, 161, 152, 147, 143, 141, 139, 138, 133, 130, 129, 118, 111, 103, 102,  96,  95,  88,  81,  80,  74,  71,  67,  66,  63,  61,  58,  55,  54,  49,  48,  43,  42,  40,  36,  34,  32,  26,  22,   8, // 'e'
+	184, 180, 127, 125, 108,  90,  17,   0, // 'f'
+	154, 148,  51, // 'g'
+	205, 155, 136, 105,  76,  52,  46,  10, // 'h'
+	185, 178, 153, 145, 126, 114, 109,  99,  77,  50,  38,  15,   3, // 'i'
+	209, 168, // 'k'
+	162, 140, 107,  72,  33, // 'l'
+	208, 201, 113, // 'm'
+	203, 173, 151, 146, 144, 134, 131, 115, 104,  97,  82,  68,  64,  59,  56,  44,  39,  37,  31,  23,  12, // 'n'
+	202, 181, 158, 150, 149, 124,  91,  30,  29,  18,   1, // 'o'
+	207, 120, // 'p'
+	 83, // 'q'
+	198, 183, 137,  93,  89,  86,  78,  47,  19,   2, // 'r'
+	206, 199, 194, 177, 169, 122, 119,  98,  60,  16, // 's'
+	204, 159, 156, 135, 132, 128, 123, 117, 101,  94,  87,  79,  75,  69,  65,  57,  53,  45,  41,  27,  24,  20,   9,   4, // 't'
+	182, 116,  92,  84,   6, // 'u'
+	186, 171, 163, 142, 110,  73,  62,  35, // 'v'
+	165, 160, 157,  70,  28,  21, // 'w'
+	179, 100, // 'x'
+	195, 176,  25,  14, // 'y'
+	112, // '*'
+};